@@ -0,0 +1,96 @@
+#ifndef ARM_H
+#define ARM_H
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "constants.h"
+#include "scheduler.h"
+
+/*
+ * Arm servo controller. moveArm() sends the arm somewhere (all at once, or at a capped speed) and optionally holds it there,
+ * and the arm task in scheduler.h does the rest in the background. The caller can either waitForArm() or go on driving
+ * while it happens - The arm keeps going as long as the code is in a control loop, schedulerSleep(), or waitForArm().
+ *
+ * We can't read where the servo actually is, so "there" means "told to go there, plus however long the servo takes to
+ * turn that far" (ARM_DEGREES_PER_SECOND). That replaces the blind Sleep(.5)s that used to follow every arm move.
+ */
+
+// How fast the servo turns on its own, unloaded - On the slow side so the arm has really gotten there when we think it has
+#define ARM_DEGREES_PER_SECOND 300
+
+enum { ARM_IDLE, ARM_MOVING, ARM_HOLDING };
+
+ROBOT_STATE int armState = ARM_IDLE;
+ROBOT_STATE float armTarget = 30, armDegreesPerStep = 0, armHoldSeconds = 0;
+ROBOT_STATE double armDoneAt = 0;
+
+// Arm has been told to go to armTarget - Works out when it'll have gotten there and held for long enough
+void startArmHold(float lastStep)
+{
+    armState = ARM_HOLDING;
+    armDoneAt = timeNow() + fabs(lastStep) / ARM_DEGREES_PER_SECOND + armHoldSeconds;
+}
+
+/**
+ * @brief stepArm is the arm's background task - Steps it towards its target at the set speed, then waits out the hold.
+ */
+void stepArm()
+{
+    if (armState == ARM_MOVING)
+    {
+        float current = robot.hardware.armServo.LastDegree();
+        if (fabs(armTarget - current) <= armDegreesPerStep)
+        {
+            robot.hardware.armServo.SetDegree(armTarget);
+            startArmHold(armTarget - current);
+        }
+        else
+            robot.hardware.armServo.SetDegree(current + (armTarget > current ? armDegreesPerStep : -armDegreesPerStep));
+    }
+    else if (armState == ARM_HOLDING && timeNow() >= armDoneAt)
+    {
+        armState = ARM_IDLE;
+        periodicTasks[ARM_TASK].isEnabled = false;
+    }
+}
+
+/**
+ * @brief moveArm starts the arm towards a degree and returns right away.
+ * @param degree is where the arm should end up.
+ * @param degreesPerSecond caps how fast the arm goes. 0 sends it there all at once (as fast as the servo goes).
+ * @param holdSeconds is how long the arm has to stay there, counted from when it gets there, before it counts as done.
+ */
+void moveArm(float degree, float degreesPerSecond = 0, float holdSeconds = 0)
+{
+    armTarget = degree;
+    armHoldSeconds = holdSeconds;
+    armDegreesPerStep = degreesPerSecond * periodicTasks[ARM_TASK].period;
+
+    if (degreesPerSecond <= 0)
+    {
+        float lastStep = degree - robot.hardware.armServo.LastDegree();
+        robot.hardware.armServo.SetDegree(degree);
+        startArmHold(lastStep);
+    }
+    else
+        armState = ARM_MOVING;
+
+    periodicTasks[ARM_TASK].isEnabled = true;
+    periodicTasks[ARM_TASK].nextRelease = timeNow() + (armState == ARM_MOVING ? 0 : periodicTasks[ARM_TASK].period);
+}
+
+// Whether the arm is still moving or holding
+bool isArmBusy() { return armState != ARM_IDLE; }
+
+/**
+ * @brief waitForArm waits until the arm has gotten where moveArm() sent it and held there for as long as it was told to.
+ */
+void waitForArm()
+{
+    while (isArmBusy())
+        schedulerSleep(periodicTasks[ARM_TASK].period);
+}
+
+#endif // ARM_H
@@ -0,0 +1,105 @@
+#ifndef BATTERY_H
+#define BATTERY_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// Custom Libraries
+#include "display.h"
+#include "recording.h"
+
+/*
+ * Battery compensation. A motor's speed goes with the voltage behind it, so as the battery runs down the same percent
+ * goes slower - And everything timed (the foosball pulls, turnNoRPS, the deadzone dead reckoning) goes a different
+ * distance. Drive (drive.h) scales every motor command by BATTERY_REFERENCE_VOLTAGE over the measured voltage, so a command
+ * goes the same speed it did when everything was tuned. A full battery gets turned down; a low one gets turned up, as far as
+ * full power allows.
+ *
+ * readBattery() keeps the measured voltage up to date as a background task (see scheduler.h), smoothed out since it dips
+ * every time the motors speed up, and has the drive re-send its command with the new compensation - Otherwise a wheel
+ * holding a steady command would keep the compensation it got when the command started. checkBattery() is the pre-run check - Goes in init(), and shows the voltage on the LCD.
+ */
+
+#define BATTERY_REFERENCE_VOLTAGE 11.7  // What everything was tuned at (and what the simulator runs at)
+#define BATTERY_LOW_VOLTAGE 11.0        // Below this, the pre-run check says to swap the battery
+#define BATTERY_SMOOTHING .2            // How much each new reading moves the measured voltage
+
+// Readings outside of this aren't the battery (running off of USB, or a bad read) - Those don't get compensated for
+#define BATTERY_MIN_VOLTAGE 9.0
+#define BATTERY_MAX_VOLTAGE 13.5
+
+void stepDrive();  // drive.h
+
+ROBOT_STATE float measuredBatteryVoltage = BATTERY_REFERENCE_VOLTAGE;
+
+// Whether a reading is worth using
+bool isBatteryReadingValid(float voltage) { return voltage >= BATTERY_MIN_VOLTAGE && voltage <= BATTERY_MAX_VOLTAGE; }
+
+// Puts the measured voltage on the LCD
+void showBatteryVoltage()
+{
+    setStatusNumber(STATUS_BATTERY, measuredBatteryVoltage < BATTERY_LOW_VOLTAGE ? "Battery LOW" : "Battery", measuredBatteryVoltage);
+}
+
+/**
+ * @brief readBattery folds a new battery reading into the measured voltage, and has the drive pick up the new compensation.
+ * Runs as a background task.
+ */
+void readBattery()
+{
+    float voltage = batteryVoltage();
+    if (!isBatteryReadingValid(voltage))
+        return;
+
+    measuredBatteryVoltage += (voltage - measuredBatteryVoltage) * BATTERY_SMOOTHING;
+    showBatteryVoltage();
+    stepDrive();
+}
+
+/**
+ * @brief compensateForBattery scales a motor power (fraction of full power) for the measured battery voltage.
+ */
+float compensateForBattery(float power)
+{
+    power *= BATTERY_REFERENCE_VOLTAGE / measuredBatteryVoltage;
+    if (power > 1)
+        return 1;
+    if (power < -1)
+        return -1;
+    return power;
+}
+
+/**
+ * @brief checkBattery is the pre-run battery check. Starts the measured voltage off at an average of a few readings, logs
+ * it, and puts it on the LCD (with a warning if it's low).
+ */
+void checkBattery()
+{
+    float total = 0;
+    int readings = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        float voltage = batteryVoltage();
+        if (isBatteryReadingValid(voltage))
+        {
+            total += voltage;
+            readings++;
+        }
+        Sleep(.01);
+    }
+
+    if (readings == 0)
+    {
+        SD.Printf("Battery: No valid readings, not compensating for the battery.\r\n");
+        setStatusMessage(STATUS_BATTERY, "Battery ???");
+        return;
+    }
+
+    measuredBatteryVoltage = total / readings;
+    SD.Printf("Battery: %f V (motor output scaled by %f).\r\n", measuredBatteryVoltage, BATTERY_REFERENCE_VOLTAGE / measuredBatteryVoltage);
+    if (measuredBatteryVoltage < BATTERY_LOW_VOLTAGE)
+        SD.Printf("Battery: Below %f V - Swap it out if there's time.\r\n", BATTERY_LOW_VOLTAGE);
+    showBatteryVoltage();
+}
+
+#endif // BATTERY_H
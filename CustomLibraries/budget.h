@@ -0,0 +1,244 @@
+#ifndef BUDGET_H
+#define BUDGET_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// Custom Libraries
+#include "constants.h"
+#include "deadline.h"
+
+/*
+ * Match-time budget. finalRoutine runs each task through runTask(), which decides right before the task whether to do
+ * all of it, a shortened version of it (a shorter DDR hold, one foosball pull instead of two), or skip it, so that whatever
+ * happens earlier in the run, there's always time left to get to the end button.
+ *
+ * The decision works off of how long each task has taken on previous runs. Those averages live in TASK_STATS_FILE on the
+ * SD card - loadTaskStats() reads them in init() and saveTaskStats() writes the updated ones back in deinit(). Without the
+ * file it falls back on the defaults in the table below, which came from Simulator/benchmark.cpp.
+ *
+ * Before every task it tries every combination of attempt/shorten/skip for the tasks that are left (3^7 at most, so this
+ * is quick) and picks the one worth the most points that fits in the time left, going with the faster one on a tie. Only
+ * the current task's part of that plan gets used - the rest gets planned over again before the next task, with the real
+ * time used so far.
+ *
+ * A task's time includes the drive to it from the task before, so skipping one doesn't save quite all of its time. The
+ * margin covers that.
+ *
+ * Replays read TASK_STATS_FILE from the working directory, so copy the one from before the run next to the log if the
+ * replay has to make the same calls.
+ */
+
+#define MATCH_TIME_LIMIT 120            // Seconds from the start light until the run has to be done
+#define MATCH_TIME_MARGIN 8             // Seconds the plan always leaves spare
+#define TASK_STATS_FILE "TASKSTAT.TXT"
+#define TASK_STATS_WEIGHT .3            // How much each new run moves the averages
+
+// Every piece of finalRoutine, in the order it's normally run
+enum { TASK_TOKEN, TASK_DDR, TASK_RPS_BUTTON, TASK_RAMP, TASK_FOOSBALL, TASK_LEVER, TASK_END_BUTTON, TASK_COUNT };
+
+// What runTask() does with a task
+enum { TASK_SKIP, TASK_SHORTEN, TASK_ATTEMPT };
+
+/**
+ * @brief TaskBudget is what the budget knows about one task.
+ * Points are what we expect to get on average, not what it's worth on paper - A shortened foosball gets the counters over
+ * less often than the full one, so it's worth less.
+ */
+struct TaskBudget
+{
+    const char *name;
+    float points, shortenedPoints;
+    float seconds, shortenedSeconds;    // Averages from previous runs - No shortenedSeconds means it can't be shortened
+    bool isRequired;                    // Always attempted, no matter what
+    int prerequisite;                   // Task that can't be skipped if this one is going to be done (-1 for none)
+
+    // This run
+    int plan;
+    bool hasRun;
+};
+
+// Order has to match the enum above
+ROBOT_STATE TaskBudget taskBudgets[TASK_COUNT] =
+{
+    { "token", 15, 0, 3.5, 0, false, -1, TASK_ATTEMPT, false },
+    { "ddr", 20, 10, 29.2, 13.9, false, -1, TASK_ATTEMPT, false },                // Shortened = 4.5 s hold, enough for the press but not the bonus
+    { "rps_button", 15, 0, 10.6, 0, false, -1, TASK_ATTEMPT, false },
+    { "ramp", 0, 0, 7.9, 0, false, TASK_RPS_BUTTON, TASK_ATTEMPT, false },        // Upper level has no RPS without the button
+    { "foosball", 20, 15, 8.8, 6.3, false, TASK_RAMP, TASK_ATTEMPT, false },      // Shortened = one pull
+    { "lever", 15, 0, 8.4, 0, false, TASK_RAMP, TASK_ATTEMPT, false },
+    { "end_button", 15, 0, 5.6, 0, true, -1, TASK_ATTEMPT, false }
+};
+
+// Runs out MATCH_TIME_LIMIT after finalRoutine starts (see startMatchBudget())
+ROBOT_STATE Deadline matchDeadline;
+
+/**
+ * @brief loadTaskStats reads the task times from previous runs off of the SD card, if there are any.
+ */
+void loadTaskStats()
+{
+    FEHFile *file = SD.FOpen(TASK_STATS_FILE, "r");
+    if (!file)
+    {
+        SD.Printf("Budget: No %s, going with the default task times.\r\n", TASK_STATS_FILE);
+        return;
+    }
+
+    for (int task = 0; task < TASK_COUNT; task++)
+    {
+        float seconds, shortenedSeconds;
+        if (SD.FScanf(file, "%f %f", &seconds, &shortenedSeconds) != 2)
+            break;
+
+        taskBudgets[task].seconds = seconds;
+        taskBudgets[task].shortenedSeconds = shortenedSeconds;
+        SD.Printf("Budget: %s takes %f s (%f s shortened).\r\n", taskBudgets[task].name, seconds, shortenedSeconds);
+    }
+    SD.FClose(file);
+}
+
+/**
+ * @brief saveTaskStats writes the task times (with this run's folded in) back to the SD card for next time.
+ */
+void saveTaskStats()
+{
+    FEHFile *file = SD.FOpen(TASK_STATS_FILE, "w");
+    if (!file)
+    {
+        SD.Printf("Budget: Couldn't write %s.\r\n", TASK_STATS_FILE);
+        return;
+    }
+
+    for (int task = 0; task < TASK_COUNT; task++)
+        SD.FPrintf(file, "%f %f\r\n", taskBudgets[task].seconds, taskBudgets[task].shortenedSeconds);
+    SD.FClose(file);
+}
+
+/**
+ * @brief startMatchBudget starts the match clock. Goes at the very start of finalRoutine.
+ */
+void startMatchBudget()
+{
+    matchDeadline = Deadline(MATCH_TIME_LIMIT);
+    for (int task = 0; task < TASK_COUNT; task++)
+        taskBudgets[task].hasRun = false;
+}
+
+/**
+ * @brief resumeMatchBudget restarts the match clock partway through, for picking a run back up after a reset (see
+ * checkpoint.h). Which tasks have run and what was planned for them have to be put back separately.
+ */
+void resumeMatchBudget(float secondsUsed)
+{
+    matchDeadline = Deadline(MATCH_TIME_LIMIT - secondsUsed);
+}
+
+// Whether doing the tasks in "plans" the way it says would mean doing something without its prerequisite
+bool breaksPrerequisites(const int plans[])
+{
+    for (int task = 0; task < TASK_COUNT; task++)
+    {
+        int prerequisite = taskBudgets[task].prerequisite;
+        if (plans[task] != TASK_SKIP && prerequisite != -1 && plans[prerequisite] == TASK_SKIP)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief planTask finds the best way to do every task that hasn't run yet in the time that's left, and returns what it
+ * says to do with the given one.
+ */
+int planTask(int current)
+{
+    float secondsLeft = matchDeadline.SecondsLeft() - MATCH_TIME_MARGIN;
+
+    // Tasks that already happened keep whatever they got
+    int plans[TASK_COUNT], bestPlans[TASK_COUNT];
+    int undecided[TASK_COUNT], undecidedCount = 0;
+    for (int task = 0; task < TASK_COUNT; task++)
+    {
+        plans[task] = bestPlans[task] = taskBudgets[task].plan;
+        if (!taskBudgets[task].hasRun)
+            undecided[undecidedCount++] = task;
+    }
+
+    // Every combination, counting in base 3
+    int combinations = 1;
+    for (int i = 0; i < undecidedCount; i++)
+        combinations *= 3;
+
+    float bestPoints = -1, bestSeconds = 0;
+    for (int combination = 0; combination < combinations; combination++)
+    {
+        float points = 0, seconds = 0;
+        bool isPossible = true;
+        for (int i = 0, digits = combination; i < undecidedCount; i++, digits /= 3)
+        {
+            const TaskBudget &budget = taskBudgets[undecided[i]];
+            int plan = plans[undecided[i]] = digits % 3;
+
+            if ((plan == TASK_SHORTEN && budget.shortenedSeconds <= 0) || (plan != TASK_ATTEMPT && budget.isRequired))
+                isPossible = false;
+            else if (plan == TASK_ATTEMPT)
+            {
+                points += budget.points;
+                seconds += budget.seconds;
+            }
+            else if (plan == TASK_SHORTEN)
+            {
+                points += budget.shortenedPoints;
+                seconds += budget.shortenedSeconds;
+            }
+        }
+
+        if (!isPossible || seconds > secondsLeft || breaksPrerequisites(plans))
+            continue;
+        if (points > bestPoints || (points == bestPoints && seconds < bestSeconds))
+        {
+            bestPoints = points;
+            bestSeconds = seconds;
+            for (int task = 0; task < TASK_COUNT; task++)
+                bestPlans[task] = plans[task];
+        }
+    }
+
+    // Nothing fits - Only the required tasks get done
+    if (bestPoints < 0)
+        return taskBudgets[current].isRequired ? TASK_ATTEMPT : TASK_SKIP;
+
+    SD.Printf("Budget: %f s left, best plan for the rest is %f points in %f s.\r\n", secondsLeft, bestPoints, bestSeconds);
+    return bestPlans[current];
+}
+
+/**
+ * @brief isTaskShortened lets a segment know it's supposed to do the quick version of its task.
+ */
+bool isTaskShortened(int task) { return taskBudgets[task].plan == TASK_SHORTEN; }
+
+/**
+ * @brief runTask runs one piece of finalRoutine if the budget says there's time for it, and folds how long it took into
+ * the averages for next time.
+ */
+void runTask(int task, void (*segment)())
+{
+    TaskBudget &budget = taskBudgets[task];
+    budget.plan = planTask(task);
+    budget.hasRun = true;
+
+    const char *planNames[] = { "Skipping", "Shortening", "Attempting" };
+    SD.Printf("Budget: %s %s.\r\n", planNames[budget.plan], budget.name);
+    if (budget.plan == TASK_SKIP)
+        return;
+
+    double startTime = timeNow();
+    segment();
+    float seconds = timeNow() - startTime;
+
+    float &average = budget.plan == TASK_ATTEMPT ? budget.seconds : budget.shortenedSeconds;
+    average += (seconds - average) * TASK_STATS_WEIGHT;
+    SD.Printf("Budget: %s took %f s, average is now %f s.\r\n", budget.name, seconds, average);
+}
+
+#endif // BUDGET_H
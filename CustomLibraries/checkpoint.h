@@ -0,0 +1,181 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// Custom Libraries
+#include "budget.h"
+#include "constants.h"
+#include "ddrlight.h"
+#include "deadline.h"
+#include "display.h"
+#include "rps.h"
+#include "scheduler.h"
+#include "taskorder.h"
+#include "utility.h"
+
+/*
+ * Checkpoints. If the Proteus resets partway through a run (a brownout, a bumped cable), main() starts over from init()
+ * and the five-touch calibrate(), and everything the run had done is gone. So after every step of finalRoutine,
+ * saveCheckpoint() writes what it would take to pick the run back up to CHECKPOINT_FILE:
+ *  - Which step is next, and how much of the match clock is used up
+ *  - Everything calibrate() found (the stations, and the light levels the DDR classifier compares against)
+ *  - Which DDR light was lit
+ *  - The task order, what the budget decided for each task, and where the robot last knew it was
+ *
+ * On boot, loadCheckpoint() reads it back in. It only counts as recent if the run that wrote it got past its first step
+ * but never got to the end (every run saves step 0 as it starts, so a finished or brand new run leaves nothing behind).
+ * That still leaves runs that got unplugged partway through at practice, so it also has to still be where that run left
+ * off - RPS has to put it within CHECKPOINT_NEAR_DISTANCE of the saved position (or in the dead zone, where it can't
+ * tell), and no RPS at all counts as starting fresh. A robot that got carried back to the start fails that on its own.
+ * Then, before resuming, it gives whoever's there CHECKPOINT_CANCEL_SECONDS to touch the screen and start fresh - In a
+ * match nobody touches it and it just keeps going.
+ * A checkpoint that got cut off partway through writing reads as incomplete and gets ignored, same as none at all.
+ *
+ * Replays read CHECKPOINT_FILE from the working directory, same as TASK_STATS_FILE (budget.h).
+ */
+
+#define CHECKPOINT_FILE "CHECKPNT.TXT"
+#define CHECKPOINT_CANCEL_SECONDS 3     // Seconds there are to touch the screen and start fresh instead of resuming
+#define CHECKPOINT_REBOOT_SECONDS 10    // Match time the reset and init() are guessed to have eaten
+#define CHECKPOINT_NEAR_DISTANCE 6      // Inches from the saved position RPS can put it and still count as the same run
+
+// Every part of robot.calibration, in the order it's written
+float Calibration::*const CHECKPOINT_CALIBRATION[] =
+{
+    &Calibration::tokenX, &Calibration::tokenY, &Calibration::tokenHeading,
+    &Calibration::ddrBlueLightX, &Calibration::ddrLightY,
+    &Calibration::rpsButtonX, &Calibration::rpsButtonY, &Calibration::rpsButtonHeading,
+    &Calibration::foosballStartX, &Calibration::foosballStartY, &Calibration::foosballEndX, &Calibration::foosballEndY,
+    &Calibration::leverX, &Calibration::leverY, &Calibration::leverHeading
+};
+const int CHECKPOINT_CALIBRATION_COUNT = sizeof(CHECKPOINT_CALIBRATION) / sizeof(CHECKPOINT_CALIBRATION[0]);
+
+// Whether finalRoutine saves checkpoints - loadCheckpoint() turns it on, so simulated runs of finalRoutine don't write any
+ROBOT_STATE bool isCheckpointing = false;
+
+/**
+ * @brief saveCheckpoint writes everything the run needs to pick back up at the given step of finalRoutine.
+ * Step 0 (the start of a run) and step TASK_COUNT (the end of one) both mean there's nothing to resume.
+ */
+void saveCheckpoint(int nextStep)
+{
+    if (!isCheckpointing)
+        return;
+
+    FEHFile *file = SD.FOpen(CHECKPOINT_FILE, "w");
+    if (!file)
+    {
+        SD.Printf("Checkpoint: Couldn't write %s.\r\n", CHECKPOINT_FILE);
+        return;
+    }
+
+    SD.FPrintf(file, "%d %f\r\n", nextStep, matchDeadline.SecondsElapsed());
+    for (int i = 0; i < CHECKPOINT_CALIBRATION_COUNT; i++)
+        SD.FPrintf(file, "%f ", robot.calibration.*CHECKPOINT_CALIBRATION[i]);
+    SD.FPrintf(file, "\r\n%f %f %f %d\r\n", lightLevels.unlit, lightLevels.red, lightLevels.blue, ddrLightColor);
+    for (int i = 0; i < TASK_COUNT; i++)
+        SD.FPrintf(file, "%d %d\r\n", taskOrder[i], taskBudgets[i].plan);
+    SD.FPrintf(file, "%f %f %f %d\r\n", robot.lastValid.x, robot.lastValid.y, robot.lastValid.heading, robot.hasExhaustedDeadzone);
+    SD.FClose(file);
+
+    SD.Printf("Checkpoint: Saved, step %d is next.\r\n", nextStep);
+}
+
+/**
+ * @brief loadCheckpoint reads CHECKPOINT_FILE and, if it's from a run that got cut off (see the top of this file), puts
+ * everything back the way it was and restarts the match clock with the time that run had used.
+ * @return The step of finalRoutine to pick back up at, or -1 to start over with calibrate().
+ */
+int loadCheckpoint()
+{
+    isCheckpointing = true;
+
+    FEHFile *file = SD.FOpen(CHECKPOINT_FILE, "r");
+    if (!file)
+    {
+        SD.Printf("Checkpoint: No %s, starting fresh.\r\n", CHECKPOINT_FILE);
+        return -1;
+    }
+
+    // Read into copies, so a bad file doesn't leave anything half-loaded
+    int nextStep;
+    float secondsUsed;
+    Calibration calibration;
+    LightLevels levels;
+    int color, order[TASK_COUNT], plans[TASK_COUNT], isExhausted;
+    PoseEstimate pose;
+
+    bool isComplete = SD.FScanf(file, "%d %f", &nextStep, &secondsUsed) == 2;
+    for (int i = 0; isComplete && i < CHECKPOINT_CALIBRATION_COUNT; i++)
+        isComplete = SD.FScanf(file, "%f", &(calibration.*CHECKPOINT_CALIBRATION[i])) == 1;
+    isComplete = isComplete && SD.FScanf(file, "%f %f %f %d", &levels.unlit, &levels.red, &levels.blue, &color) == 4;
+    for (int i = 0; isComplete && i < TASK_COUNT; i++)
+        isComplete = SD.FScanf(file, "%d %d", &order[i], &plans[i]) == 2 && order[i] >= 0 && order[i] < TASK_COUNT;
+    isComplete = isComplete && SD.FScanf(file, "%f %f %f %d", &pose.x, &pose.y, &pose.heading, &isExhausted) == 4;
+    SD.FClose(file);
+
+    if (!isComplete)
+    {
+        SD.Printf("Checkpoint: %s is incomplete, starting fresh.\r\n", CHECKPOINT_FILE);
+        return -1;
+    }
+    if (nextStep <= 0 || nextStep >= TASK_COUNT)
+    {
+        SD.Printf("Checkpoint: Last run finished, starting fresh.\r\n");
+        return -1;
+    }
+
+    // Has to still be where that run left off, otherwise it's an old file from a run that got moved or carried off
+    int rpsWait = loopUntilValidRPS();
+    if (rpsWait == -1)
+    {
+        SD.Printf("Checkpoint: No RPS to check the position against, starting fresh.\r\n");
+        return -1;
+    }
+    if (rpsWait == 0 && getDistance(rpsX(), rpsY(), pose.x, pose.y) > CHECKPOINT_NEAR_DISTANCE)
+    {
+        SD.Printf("Checkpoint: At (%f, %f), but step %d was saved at (%f, %f) - Starting fresh.\r\n", rpsX(), rpsY(), nextStep,
+                  pose.x, pose.y);
+        return -1;
+    }
+
+    // Last chance to say it isn't from this run - Waits for the finger to come back off, so calibrate() doesn't take it
+    SD.Printf("Checkpoint: Found step %d, touch within %d s to start fresh instead.\r\n", nextStep, CHECKPOINT_CANCEL_SECONDS);
+    setStatusMessage("Resuming - Touch to start over.");
+    Deadline cancelWindow(CHECKPOINT_CANCEL_SECONDS);
+    float touchX, touchY;
+    while (!cancelWindow.HasPassed())
+    {
+        if (lcdTouch(&touchX, &touchY))
+        {
+            while (lcdTouch(&touchX, &touchY))
+                schedulerSleep(.1);
+            SD.Printf("Checkpoint: Touched, starting fresh.\r\n");
+            return -1;
+        }
+        schedulerSleep(.1);
+    }
+
+    robot.calibration = calibration;
+    lightLevels = levels;
+    ddrLightColor = color;
+    robot.lastValid = pose;
+    robot.hasExhaustedDeadzone = isExhausted != 0;
+    for (int i = 0; i < TASK_COUNT; i++)
+    {
+        taskOrder[i] = order[i];
+        taskBudgets[i].plan = plans[i];
+        taskBudgets[i].hasRun = false;
+    }
+    for (int i = 0; i < nextStep; i++)
+        taskBudgets[taskOrder[i]].hasRun = true;
+
+    resumeMatchBudget(secondsUsed + CHECKPOINT_REBOOT_SECONDS);
+    SD.Printf("Checkpoint: Resuming at step %d (%s), %f s into the match.\r\n", nextStep, taskBudgets[taskOrder[nextStep]].name,
+              secondsUsed + CHECKPOINT_REBOOT_SECONDS);
+    return nextStep;
+}
+
+#endif // CHECKPOINT_H
@@ -6,21 +6,63 @@
 #include <FEHServo.h>
 #include <FEHIO.h>
 
-// No custom library imports needed (screws up all sorts of things, anyways)
-
-// I/O 
-FEHMotor leftMotor(FEHMotor::Motor0, 9.0);
-FEHMotor rightMotor(FEHMotor::Motor1, 9.0);
-FEHServo armServo(FEHServo::Servo0);
-DigitalInputPin bumpSwitch(FEHIO::P0_1);
-AnalogInputPin lightSensor(FEHIO::P0_0);
-
-// Calibration values for RPS pathfinding
-float TOKEN_X, TOKEN_Y, TOKEN_HEADING;
-float DDR_BLUE_LIGHT_X, DDR_LIGHT_Y;
-float RPS_BUTTON_X, RPS_BUTTON_Y, RPS_BUTTON_HEADING;
-float FOOSBALL_START_X, FOOSBALL_START_Y, FOOSBALL_END_X, FOOSBALL_END_Y;
-float LEVER_X, LEVER_Y, LEVER_HEADING;
+// Only custom library import - Doesn't depend on anything else (anything more screws up all sorts of things, anyways)
+#include "recording.h"
+
+/*
+ * Everything about the robot that changes while it runs - Its hardware, what calibrate() found, where it last knew it was,
+ * and the deadzone flag - lives in "robot". On the Proteus that's just a global. In the simulator it's thread_local (see
+ * ROBOT_STATE in recording.h), so each simulation thread gets a robot of its own.
+ */
+
+const FEHIO::FEHIOPin LEFT_ENCODER_PIN = FEHIO::P1_0, RIGHT_ENCODER_PIN = FEHIO::P1_1;
+
+// I/O (Recorded versions are drop-in replacements that also log to SD; see recording.h)
+struct RobotHardware
+{
+    RecordedMotor leftMotor, rightMotor;
+    RecordedServo armServo;
+    RecordedDigitalInputPin bumpSwitch;
+    RecordedAnalogInputPin lightSensor;
+    RecordedDigitalEncoder leftEncoder, rightEncoder;
+
+    RobotHardware() : leftMotor(FEHMotor::Motor0, 9.0, 'L'), rightMotor(FEHMotor::Motor1, 9.0, 'R'), armServo(FEHServo::Servo0),
+                      bumpSwitch(FEHIO::P0_1), lightSensor(FEHIO::P0_0), leftEncoder(LEFT_ENCODER_PIN, 'E'),
+                      rightEncoder(RIGHT_ENCODER_PIN, 'F') {}
+};
+
+// Calibration values for RPS pathfinding - Filled in by calibrate() (pretest.h)
+struct Calibration
+{
+    float tokenX, tokenY, tokenHeading;
+    float ddrBlueLightX, ddrLightY;
+    float rpsButtonX, rpsButtonY, rpsButtonHeading;
+    float foosballStartX, foosballStartY, foosballEndX, foosballEndY;
+    float leverX, leverY, leverHeading;
+};
+
+// Basically cached RPS values that allow the robot to semi-intelligently get back to RPS from deadzone
+struct PoseEstimate
+{
+    float x, y, heading;
+};
+
+struct Robot
+{
+    RobotHardware hardware;
+    Calibration calibration;
+    PoseEstimate lastValid;
+
+    // Lets us conditionally skip RPS-dependent functions when in effective deadzone
+    bool hasExhaustedDeadzone;
+
+    // Tracks what percentage the motors are currently at (kept up to date by Drive in drive.h) - Purely for debugging
+    float leftMotorPercent, rightMotorPercent;
+
+    Robot() : calibration(), lastValid(), hasExhaustedDeadzone(false), leftMotorPercent(-1), rightMotorPercent(-1) {}
+};
+
+ROBOT_STATE Robot robot;
 
 // Motor Percentages & Sign Fixes
 const int LEFT_MOTOR_SIGN_FIX = -1;
@@ -29,9 +71,8 @@ const float DEFAULT_MOTOR_PERCENT = 100;
 const float LEFT_MOTOR_PERCENT = LEFT_MOTOR_SIGN_FIX * DEFAULT_MOTOR_PERCENT;
 const float RIGHT_MOTOR_PERCENT = RIGHT_MOTOR_SIGN_FIX * DEFAULT_MOTOR_PERCENT;
 
-// Tracks what percentage the motors are currently at - Purely for debugging
-float currentLeftMotorPercent = -1;
-float currentRightMotorPercent = -1;
+// Inches between the wheels (centers of the treads)
+const float TRACK_WIDTH = 7.0;
 
 // Cardinal Headings 
 const float NORTH = 90;
@@ -43,12 +84,6 @@ const float WEST = 180;
 const float DEGREES_PER_SECOND = (1080 / 10.0);
 const float SECONDS_PER_DEGREE = (10.0 / 1080);
 
-// Global boolean that lets us conditionally skip RPS-dependent functions when in effective deadzone
-bool hasExhaustedDeadzone = false;
-
-// Basically cached RPS values that allow the robot to semi-intelligently get back to RPS from deadzone
-float lastValidX, lastValidY, lastValidHeading;
-
 // Used to account for differences between RPS coordinates and where our robot turns around (the centroid) 
 const float DISTANCE_BETWEEN_RPS_AND_CENTROID = 0;
 
@@ -15,40 +15,40 @@ float degreeToRadian(float degreeValue) { return degreeValue * (PI / 180.0); }
 float rpsXToCentroidX()
 {
     // 0 Degrees (Inclusive) to 90 Degrees (Exclusive)
-    if (RPS.Heading() >= 0 && RPS.Heading() < 90)
-        return RPS.X() + DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(RPS.Heading()));
+    if (rpsHeading() >= 0 && rpsHeading() < 90)
+        return rpsX() + DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(rpsHeading()));
 
     // 90 Degrees (Inclusive) to 180 Degrees (Exclusive)
-    else if (RPS.Heading() >= 90 && RPS.Heading() < 180)
-        return RPS.X() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(RPS.Heading() - 90)));
+    else if (rpsHeading() >= 90 && rpsHeading() < 180)
+        return rpsX() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(rpsHeading() - 90)));
 
     // 180 Degrees (Inclusve) to 270 Degrees (Exclusive)
-    else if (RPS.Heading() >= 180 && RPS.Heading() < 270)
-        return RPS.X() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(RPS.Heading() - 180)));
+    else if (rpsHeading() >= 180 && rpsHeading() < 270)
+        return rpsX() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(rpsHeading() - 180)));
 
     // 270 Degrees (Inclusive) to 360 Degrees (Inclusive)
     else
-        return RPS.X() + (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(RPS.Heading() - 270)));
+        return rpsX() + (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(rpsHeading() - 270)));
 }
 
 // If there's distance between QR code and centroid, this is implemented into the relevant functions
 float rpsYToCentroidY()
 {
     // 0 Degrees (Inclusive) to 90 Degrees (Exclusive)
-    if (RPS.Heading() >= 0 && RPS.Heading() < 90)
-        return RPS.Y() + (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(RPS.Heading())));
+    if (rpsHeading() >= 0 && rpsHeading() < 90)
+        return rpsY() + (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(rpsHeading())));
 
     // 90 Degrees (Inclusive) to 180 Degrees (Exclusive)
-    else if (RPS.Heading() >= 90 && RPS.Heading() < 180)
-        return RPS.Y() + (DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(RPS.Heading() - 90)));
+    else if (rpsHeading() >= 90 && rpsHeading() < 180)
+        return rpsY() + (DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(rpsHeading() - 90)));
 
     // 180 Degrees (Inclusive) to 270 Degrees (Exclusive)
-    else if (RPS.Heading() >= 180 && RPS.Heading() < 270)
-        return RPS.Y() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(RPS.Heading() - 180)));
+    else if (rpsHeading() >= 180 && rpsHeading() < 270)
+        return rpsY() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * sin(degreeToRadian(rpsHeading() - 180)));
 
     // 270 Degrees (Inclusive) to 360 Degrees (Inclusive)
     else
-        return RPS.Y() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(RPS.Heading() - 270)));
+        return rpsY() - (DISTANCE_BETWEEN_RPS_AND_CENTROID * cos(degreeToRadian(rpsHeading() - 270)));
 }
 
 // Takes in an angle and returns whatever's 180 degrees from it, accounting for overflow for high angles
@@ -0,0 +1,92 @@
+#ifndef COURSE_H
+#define COURSE_H
+
+// No imports needed - Just geometry
+
+/*
+ * Rough map of the course, in RPS coordinates (inches, origin at the bottom left corner). Only the stuff we could run into is
+ * in here - The task stations themselves come from calibrate(). Everything is a rectangle because that's close enough for
+ * staying out of the way of things, and it keeps the collision checks cheap.
+ *
+ * These were measured off of the course drawings, so they're good to maybe half an inch. Anything that plans around them
+ * should leave some clearance on top of ROBOT_RADIUS.
+ */
+
+// Course outline
+const float COURSE_WIDTH = 36;
+const float COURSE_HEIGHT = 72;
+
+// Radius of a circle around the robot's centroid that covers the whole chassis
+const float ROBOT_RADIUS = 4.5;
+
+/**
+ * @brief CourseObstacle is one thing on the course the robot can hit.
+ * isPushedOn is true for things we drive into on purpose (the DDR buttons), so running into them isn't a collision.
+ */
+struct CourseObstacle
+{
+    const char *name;
+    float left, bottom, right, top;
+    bool isPushedOn;
+};
+
+const CourseObstacle COURSE_OBSTACLES[] =
+{
+    { "DDR machine (buttons on top edge)", 20, 2, 31, 7.5, true },
+    { "Token machine", 12, 25.5, 15.5, 30, false },
+    { "RPS button post", 16.5, 27.5, 19.5, 30.5, false },
+    { "Dodecahedron", 13, 31.5, 20, 37, false },
+    { "Upper level edge", 12, 38, 24.5, 41, false },
+    { "Foosball table", 18, 67, 36, 72, false },
+    { "Lever stand", 2, 63, 8, 68, false }
+};
+const int COURSE_OBSTACLE_COUNT = sizeof(COURSE_OBSTACLES) / sizeof(COURSE_OBSTACLES[0]);
+
+// The ramp up to the upper level (the left side of the course, x < 12, is a gentler slope)
+const float COURSE_RAMP_LEFT = 24.5, COURSE_RAMP_RIGHT = 32.5, COURSE_RAMP_BOTTOM = 22, COURSE_RAMP_TOP = 40;
+
+// Everything from here up is the upper level
+const float COURSE_UPPER_LEVEL_Y = 41;
+
+/**
+ * @brief courseObstacleAt reports what a circle of the given radius at (x, y) would be hitting.
+ * @return The index into COURSE_OBSTACLES, -2 for the course walls, or -1 if it's clear.
+ */
+int courseObstacleAt(float x, float y, float radius)
+{
+    if (x < radius || x > COURSE_WIDTH - radius || y < radius || y > COURSE_HEIGHT - radius)
+        return -2;
+
+    for (int i = 0; i < COURSE_OBSTACLE_COUNT; i++)
+    {
+        // Closest point on the rectangle to the center of the circle
+        float closestX = x < COURSE_OBSTACLES[i].left ? COURSE_OBSTACLES[i].left : (x > COURSE_OBSTACLES[i].right ? COURSE_OBSTACLES[i].right : x);
+        float closestY = y < COURSE_OBSTACLES[i].bottom ? COURSE_OBSTACLES[i].bottom : (y > COURSE_OBSTACLES[i].top ? COURSE_OBSTACLES[i].top : y);
+
+        if ((x - closestX) * (x - closestX) + (y - closestY) * (y - closestY) < radius * radius)
+            return i;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief courseSegmentIsClear checks a straight drive from (x1, y1) to (x2, y2), a quarter inch at a time.
+ * @param clearance is how far the robot's centroid has to stay from everything (usually ROBOT_RADIUS plus some margin).
+ */
+bool courseSegmentIsClear(float x1, float y1, float x2, float y2, float clearance)
+{
+    float length = sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1));
+    int steps = (int) (length / .25) + 1;
+
+    for (int i = 0; i <= steps; i++)
+    {
+        float fraction = (float) i / steps;
+        if (courseObstacleAt(x1 + (x2 - x1) * fraction, y1 + (y2 - y1) * fraction, clearance) != -1)
+            return false;
+    }
+
+    return true;
+}
+
+#endif // COURSE_H
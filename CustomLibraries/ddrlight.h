@@ -0,0 +1,234 @@
+#ifndef DDRLIGHT_H
+#define DDRLIGHT_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "constants.h"
+#include "conversions.h"
+#include "drive.h"
+#include "scheduler.h"
+#include "utility.h"
+
+/*
+ * DDR light classifier. Instead of parking on the red light, stopping, and reading the CdS cell once, ddrSegment turns on
+ * sampling and pushes towards the red button, right over the red light. Every DDR_LIGHT_SAMPLE_PERIOD the background task below reads the cell and
+ * tags the reading with where the robot thought the cell was right then (robot.lastValid, which goToPoint keeps up to
+ * date). classifyDDRLight() then looks at the brightest reading it got near each light:
+ *  - Near the red light - Lit red reads way brighter than anything else on the course
+ *  - Near the blue light - Lit blue reads brighter than an unlit spot, but not by as much
+ * Each light that got looked at says how sure it is that it's lit (how far past its cutoff the reading was), and the two get
+ * combined into a color and a confidence. One bright reading in a pass beats one reading wherever the robot happened to
+ * stop, and it works whether the robot stops on the light or not.
+ *
+ * The push doesn't stop on the light to decide - If red's lit it just keeps going into the red button, and
+ * hasRuledOutRedLight() stops it partway as soon as the cell's been right over the red light without seeing it lit, so it
+ * can head for the blue button instead.
+ *
+ * The levels it compares against get captured in calibrate(): the token station is away from both lights, so that's the
+ * unlit level, and the DDR station sits on the blue light, so if blue is lit then, that's the blue level. Lit red would
+ * take another station to see, so red stays at its default. The defaults are what the old fixed 1.0 cutoff came from.
+ */
+
+#define DDR_LIGHT_RADIUS 2.0            // Inches from a light's center that a sample counts as looking at it - The cell
+                                        // sees a light from 1.5 in, plus some slack for RPS lagging behind
+#define DDR_LIGHT_SAMPLE_PERIOD .02     // Seconds between samples
+#define DDR_LIGHT_MAX_SAMPLES 250       // Five seconds' worth - Anything after that gets dropped
+#define LIGHT_SENSOR_OFFSET 0           // Inches in front of the RPS point that the CdS cell is
+
+// Which light is lit (ddrLightColor is -1 until it's been read)
+enum { DDR_RED, DDR_BLUE };
+ROBOT_STATE int ddrLightColor = -1;
+
+// CdS cell readings, in volts - Brighter light reads lower
+struct LightLevels
+{
+    float unlit, red, blue;
+
+    // Halfway between each lit level and whatever it gets told apart from
+    float RedCutoff() const { return (red + blue) / 2; }
+    float BlueCutoff() const { return (blue + unlit) / 2; }
+};
+ROBOT_STATE LightLevels lightLevels = { 2.2, .45, 1.35 };
+
+// One reading of the cell, and where it was
+struct LightSample
+{
+    float reading;
+    float x, y, heading;
+};
+
+ROBOT_STATE LightSample lightSamples[DDR_LIGHT_MAX_SAMPLES];
+ROBOT_STATE int lightSampleCount = 0;
+
+// What classifyDDRLight() decided
+struct LightDecision
+{
+    int color;
+    float confidence;       // 0 is a coin flip, 1 is as sure as it gets
+};
+
+/**
+ * @brief isRedLightReading is the one-reading version, for when the cell's sitting right on the red light.
+ */
+bool isRedLightReading(float reading) { return reading < lightLevels.RedCutoff(); }
+
+// Average of a few readings of the cell, wherever it is right now
+float averageLightReading()
+{
+    float total = 0;
+    for (int i = 0; i < 5; i++)
+    {
+        total += robot.hardware.lightSensor.Value();
+        Sleep(.01);
+    }
+    return total / 5;
+}
+
+/**
+ * @brief captureUnlitLightLevel goes in calibrate() at a station away from the DDR lights.
+ */
+void captureUnlitLightLevel()
+{
+    lightLevels.unlit = averageLightReading();
+    SD.Printf("DDR Light: Unlit reads %f.\r\n", lightLevels.unlit);
+}
+
+/**
+ * @brief captureDDRLightLevel goes in calibrate() at the DDR station (on the blue light), after captureUnlitLightLevel().
+ */
+void captureDDRLightLevel()
+{
+    float reading = averageLightReading();
+    if (reading < lightLevels.BlueCutoff())
+    {
+        lightLevels.blue = reading;
+        SD.Printf("DDR Light: Blue reads %f.\r\n", reading);
+    }
+    else
+        SD.Printf("DDR Light: Blue light isn't lit right now (reads %f), keeping %f for blue.\r\n", reading, lightLevels.blue);
+    SD.Printf("DDR Light: Red cutoff %f, blue cutoff %f.\r\n", lightLevels.RedCutoff(), lightLevels.BlueCutoff());
+}
+
+/**
+ * @brief sampleDDRLight is the sampling background task - Reads the cell and tags the reading with where the cell was.
+ */
+void sampleDDRLight()
+{
+    if (lightSampleCount >= DDR_LIGHT_MAX_SAMPLES)
+        return;
+
+    LightSample &sample = lightSamples[lightSampleCount++];
+    sample.reading = robot.hardware.lightSensor.Value();
+    sample.heading = robot.lastValid.heading;
+    sample.x = robot.lastValid.x + LIGHT_SENSOR_OFFSET * cos(degreeToRadian(robot.lastValid.heading));
+    sample.y = robot.lastValid.y + LIGHT_SENSOR_OFFSET * sin(degreeToRadian(robot.lastValid.heading));
+}
+
+/**
+ * @brief startDDRLightSampling starts sampling the cell in the background. Call it before driving over the lights.
+ */
+void startDDRLightSampling()
+{
+    lightSampleCount = 0;
+    PeriodicTask &task = periodicTasks[DDR_LIGHT_TASK];
+    task.isEnabled = true;
+    task.nextRelease = timeNow();
+}
+
+/**
+ * @brief hasRuledOutRedLight is for pushing over the red light towards its button (see the top of this file) - Whether the
+ * cell has gotten past the middle of it (going whichever way the robot's facing) without any sample near it looking lit.
+ */
+bool hasRuledOutRedLight()
+{
+    float redX = robot.calibration.ddrBlueLightX - 4.25;
+    bool hasPassed = false;
+    for (int i = 0; i < lightSampleCount; i++)
+    {
+        const LightSample &sample = lightSamples[i];
+        if (getDistance(sample.x, sample.y, redX, robot.calibration.ddrLightY) > DDR_LIGHT_RADIUS)
+            continue;
+        if (isRedLightReading(sample.reading))
+            return false;
+
+        // Past the middle is where the light's behind the cell
+        float heading = degreeToRadian(sample.heading);
+        if ((redX - sample.x) * cos(heading) + (robot.calibration.ddrLightY - sample.y) * sin(heading) <= 0)
+            hasPassed = true;
+    }
+    return hasPassed;
+}
+
+// How sure one light's brightest reading is that the light's lit, from -1 (definitely not) to 1 (definitely is)
+float lightEvidence(float brightest, float cutoff, float litLevel, float unlitLevel)
+{
+    float evidence = brightest < cutoff ? (cutoff - brightest) / (cutoff - litLevel) : -(brightest - cutoff) / (unlitLevel - cutoff);
+    if (evidence > 1)
+        return 1;
+    if (evidence < -1)
+        return -1;
+    return evidence;
+}
+
+/**
+ * @brief classifyDDRLight stops sampling and decides which light is lit from the samples (see the top of this file). If
+ * no sample got near either light, it falls back on stopping and reading the cell once, with no confidence.
+ */
+LightDecision classifyDDRLight()
+{
+    periodicTasks[DDR_LIGHT_TASK].isEnabled = false;
+
+    // Brightest reading near each light
+    float redX = robot.calibration.ddrBlueLightX - 4.25, blueX = robot.calibration.ddrBlueLightX;
+    float brightestRed = -1, brightestBlue = -1;
+    int redSamples = 0, blueSamples = 0;
+    for (int i = 0; i < lightSampleCount; i++)
+    {
+        const LightSample &sample = lightSamples[i];
+        if (getDistance(sample.x, sample.y, redX, robot.calibration.ddrLightY) <= DDR_LIGHT_RADIUS)
+        {
+            if (redSamples++ == 0 || sample.reading < brightestRed)
+                brightestRed = sample.reading;
+        }
+        else if (getDistance(sample.x, sample.y, blueX, robot.calibration.ddrLightY) <= DDR_LIGHT_RADIUS)
+        {
+            if (blueSamples++ == 0 || sample.reading < brightestBlue)
+                brightestBlue = sample.reading;
+        }
+    }
+
+    LightDecision decision;
+    if (redSamples == 0 && blueSamples == 0)
+    {
+        drive.Stop();
+        float reading = robot.hardware.lightSensor.Value();
+        decision.color = isRedLightReading(reading) ? DDR_RED : DDR_BLUE;
+        decision.confidence = 0;
+        SD.Printf("DDR Light: None of %d samples were near a light - Stopped and read %f.\r\n", lightSampleCount, reading);
+    }
+    else
+    {
+        // Positive is red, negative is blue
+        float score = 0;
+        if (redSamples > 0)
+            score += lightEvidence(brightestRed, lightLevels.RedCutoff(), lightLevels.red, lightLevels.unlit);
+        if (blueSamples > 0)
+            score -= lightEvidence(brightestBlue, lightLevels.BlueCutoff(), lightLevels.blue, lightLevels.unlit);
+
+        decision.color = score > 0 ? DDR_RED : DDR_BLUE;
+        decision.confidence = fabs(score) > 1 ? 1 : fabs(score);
+        SD.Printf("DDR Light: %d samples on red (brightest %f), %d on blue (brightest %f).\r\n", redSamples, brightestRed,
+                  blueSamples, brightestBlue);
+    }
+
+    ddrLightColor = decision.color;
+    SD.Printf("DDR Light: %s, confidence %f.\r\n", decision.color == DDR_RED ? "Red" : "Blue", decision.confidence);
+    return decision;
+}
+
+#endif // DDRLIGHT_H
@@ -0,0 +1,42 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+// Custom Libraries
+#include "recording.h"
+
+/*
+ * Deadlines for blocking loops. Anything that waits on the outside world (RPS coming back, a turn settling, the start light)
+ * makes one of these before it starts and checks HasPassed() every pass, so how long it waits only depends on the clock -
+ * Not on how many passes it got through, which changes with how much logging and drawing each pass does.
+ *
+ * Reads the clock through timeNow(), so replays give up at exactly the same spot the robot did.
+ */
+class Deadline
+{
+public:
+    // One that never passes - For loops that only sometimes have a time limit. Doesn't read the clock, so it's fine as a global.
+    Deadline() : start(0), end(-1) {}
+
+    // Passes the given number of seconds from now
+    explicit Deadline(float seconds) : start(timeNow()), end(start + seconds) {}
+
+    bool HasPassed() { return end >= 0 && timeNow() >= end; }
+    bool IsSet() { return end >= 0; }
+
+    // Seconds since it was made
+    float SecondsElapsed() { return timeNow() - start; }
+
+    // Seconds until it passes (0 once it has, and a really big number if it never will)
+    float SecondsLeft()
+    {
+        if (end < 0)
+            return 1e9;
+        double left = end - timeNow();
+        return left > 0 ? left : 0;
+    }
+
+private:
+    double start, end;
+};
+
+#endif // DEADLINE_H
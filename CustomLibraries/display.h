@@ -0,0 +1,117 @@
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+// FEH Libraries
+#include <FEHLCD.h>
+
+// C/C++ Libraries
+#include <cstring>
+
+/*
+ * Status display. Clearing and rewriting the whole LCD takes long enough to throw off a control loop, so nothing outside
+ * this file draws on the screen during a run. Everything else just updates the fields below (setStatusMessage(),
+ * setStatusNumber()), which only touches memory. refreshStatusDisplay() runs a few times a second as a background task
+ * (see scheduler.h) and only redraws the rows that actually changed since the last time.
+ */
+
+// What each row of the screen shows
+enum
+{
+    STATUS_MESSAGE,
+    STATUS_X,
+    STATUS_Y,
+    STATUS_HEADING,
+    STATUS_INTENDED_HEADING,
+    STATUS_BATTERY,
+    STATUS_FIELD_COUNT
+};
+
+// One row of the screen - A label, and optionally a number after it
+struct StatusField
+{
+    char label[27];
+    bool hasNumber;
+    float number;
+};
+
+// Pixels per row of text (the Proteus font is 12x17)
+#define STATUS_ROW_HEIGHT 17
+#define STATUS_CHARACTER_WIDTH 12
+
+ROBOT_STATE StatusField statusFields[STATUS_FIELD_COUNT];   // What the screen should say
+ROBOT_STATE StatusField shownFields[STATUS_FIELD_COUNT];    // What it says right now
+ROBOT_STATE bool isStatusRowShown[STATUS_FIELD_COUNT];      // False if that row needs drawn no matter what
+
+/**
+ * @brief setStatusMessage sets a row to just text.
+ */
+void setStatusMessage(int field, const char *text)
+{
+    strncpy(statusFields[field].label, text, sizeof(statusFields[field].label) - 1);
+    statusFields[field].label[sizeof(statusFields[field].label) - 1] = '\0';
+    statusFields[field].hasNumber = false;
+}
+
+// Most callers only have the one message
+void setStatusMessage(const char *text) { setStatusMessage(STATUS_MESSAGE, text); }
+
+/**
+ * @brief setStatusNumber sets a row to a label followed by a number (like "Heading 92.5").
+ */
+void setStatusNumber(int field, const char *label, float number)
+{
+    setStatusMessage(field, label);
+    statusFields[field].hasNumber = true;
+    statusFields[field].number = number;
+}
+
+// Whether a row would look any different if it got redrawn (numbers get drawn to a tenth, so noise past that doesn't count)
+bool statusFieldChanged(int field)
+{
+    const StatusField &wanted = statusFields[field], &shown = shownFields[field];
+    if (!isStatusRowShown[field] || strcmp(wanted.label, shown.label) != 0 || wanted.hasNumber != shown.hasNumber)
+        return true;
+    return wanted.hasNumber && (int) (wanted.number * 10) != (int) (shown.number * 10);
+}
+
+/**
+ * @brief refreshStatusDisplay redraws every row that changed, and nothing else.
+ */
+void refreshStatusDisplay()
+{
+    for (int field = 0; field < STATUS_FIELD_COUNT; field++)
+    {
+        if (!statusFieldChanged(field))
+            continue;
+
+        int y = field * STATUS_ROW_HEIGHT;
+        LCD.SetFontColor(FEHLCD::Black);
+        LCD.FillRectangle(0, y, 320, STATUS_ROW_HEIGHT);
+        LCD.SetFontColor(FEHLCD::White);
+
+        LCD.WriteAt(statusFields[field].label, 0, y);
+        if (statusFields[field].hasNumber)
+            LCD.WriteAt(statusFields[field].number, (int) (strlen(statusFields[field].label) + 1) * STATUS_CHARACTER_WIDTH, y);
+
+        shownFields[field] = statusFields[field];
+        isStatusRowShown[field] = true;
+    }
+}
+
+/**
+ * @brief clearStatusDisplay blanks the screen and every field. Only for outside of a run - It's a full clear.
+ */
+void clearStatusDisplay()
+{
+    LCD.Clear(FEHLCD::Black);
+    LCD.SetFontColor(FEHLCD::White);
+
+    for (int field = 0; field < STATUS_FIELD_COUNT; field++)
+    {
+        setStatusMessage(field, "");
+        shownFields[field] = statusFields[field];
+        isStatusRowShown[field] = true;
+    }
+}
+
+#endif // DISPLAY_H
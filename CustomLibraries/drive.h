@@ -0,0 +1,190 @@
+#ifndef DRIVE_H
+#define DRIVE_H
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "battery.h"
+#include "constants.h"
+#include "recording.h"
+#include "scheduler.h"
+
+/*
+ * Drive train. Everything that moves the robot goes through the one Drive below instead of setting the motors itself, so
+ *  - Both motors always get set together, with the sign fixes (LEFT_MOTOR_PERCENT/RIGHT_MOTOR_PERCENT) applied in one spot
+ *  - What the motors were last told (robot.leftMotorPercent/robot.rightMotorPercent) always matches what they really got
+ *  - How quickly the wheels are allowed to change speed is limited in one spot
+ *  - The motor maps below and the battery compensation (battery.h) get applied to everything - When the measured voltage
+ *    moves, readBattery() has the drive re-send whatever it's holding, so a steady command keeps up with the battery
+ *
+ * Commands are fractions of full power, positive being forwards for both wheels. Set() takes them as (linear, angular) -
+ * How fast to go forwards and how hard to turn left - and SetWheels() takes each wheel on its own. Once the motor maps
+ * below are fitted, they're really fractions of top speed - The same command gets both wheels going the same speed.
+ *
+ * The limits: each wheel can only speed up by accelerationLimit (fraction of full power per second), and only change at
+ * all by slewLimit, so the treads don't slip when going from a stop to a fast mode or from a turn one way to the other.
+ * Stop() and Pulse() skip the limits - Stopping should never be put off, and the precise turns' pulses are tuned by length.
+ * Whatever a command couldn't get to right away, the drive task in scheduler.h keeps stepping it towards - So the rest of
+ * the way only happens in a control loop, schedulerSleep() or waitForArm(), not a plain Sleep().
+ */
+
+// Hand-tuned - Fraction of full power per second (0 turns a limit off)
+#define DRIVE_ACCELERATION_LIMIT 20
+#define DRIVE_SLEW_LIMIT 0
+
+/**
+ * @brief MotorMap is what one motor really needs to be told to go a given fraction of the robot's top speed - Our motors
+ * don't match, and neither goes the same speed backwards as forwards. The deadband is how much power it takes to get the
+ * wheel moving at all, and the gain is how much more power it takes per fraction of top speed after that. Fitted by
+ * fitMotorMaps() (motormap.h); until then it changes nothing.
+ */
+struct MotorMap
+{
+    float forwardDeadband, forwardGain;
+    float backwardDeadband, backwardGain;
+
+    // Fraction of top speed to fraction of full power, which is what actually goes to the motor
+    float Power(float fraction) const
+    {
+        if (fraction == 0)
+            return 0;
+
+        float power = fraction > 0 ? forwardDeadband + fraction * forwardGain : -backwardDeadband + fraction * backwardGain;
+        if (power > 1)
+            return 1;
+        if (power < -1)
+            return -1;
+        return power;
+    }
+};
+
+const MotorMap UNFITTED_MOTOR_MAP = { 0, 1, 0, 1 };
+ROBOT_STATE MotorMap leftMotorMap = UNFITTED_MOTOR_MAP, rightMotorMap = UNFITTED_MOTOR_MAP;
+
+class Drive
+{
+public:
+    Drive(RecordedMotor &left, RecordedMotor &right)
+        : leftWheel(left), rightWheel(right), leftTarget(0), rightTarget(0), left(0), right(0), leftPercent(0), rightPercent(0), lastUpdate(-1),
+          accelerationLimit(DRIVE_ACCELERATION_LIMIT), slewLimit(DRIVE_SLEW_LIMIT) {}
+
+    // Forwards at "linear" while turning left at "angular" (each wheel differs from linear by angular)
+    void Set(float linear, float angular) { SetWheels(linear - angular, linear + angular); }
+
+    void SetWheels(float leftFraction, float rightFraction)
+    {
+        // Coming from sitting still at the last command, it gets one drive task's worth of change right away
+        if (IsSettled())
+            lastUpdate = timeNow() - periodicTasks[DRIVE_TASK].period;
+
+        leftTarget = leftFraction;
+        rightTarget = rightFraction;
+        Update();
+    }
+
+    // Straight to the given speeds, limits or not
+    void Pulse(float leftFraction, float rightFraction)
+    {
+        leftTarget = leftFraction;
+        rightTarget = rightFraction;
+        Apply(leftFraction, rightFraction);
+    }
+
+    void Stop() { Pulse(0, 0); }
+
+    void SetLimits(float acceleration, float slew)
+    {
+        accelerationLimit = acceleration;
+        slewLimit = slew;
+    }
+
+    /**
+     * @brief Update moves the wheels as far towards where they were told to go as the limits allow since the last update.
+     */
+    void Update()
+    {
+        double now = timeNow();
+        float seconds = lastUpdate < 0 ? 0 : now - lastUpdate;
+        Apply(Step(left, leftTarget, seconds), Step(right, rightTarget, seconds));
+    }
+
+    bool IsSettled() const { return left == leftTarget && right == rightTarget; }
+
+    // What the wheels were last actually told, as fractions of full power
+    float Left() const { return left; }
+    float Right() const { return right; }
+
+private:
+    RecordedMotor &leftWheel, &rightWheel;
+    float leftTarget, rightTarget;
+    float left, right;
+    float leftPercent, rightPercent;    // What each motor was last sent, battery compensation and all
+    double lastUpdate;
+    float accelerationLimit, slewLimit;
+
+    // One wheel's next speed - As close to target as it can get in the given time
+    float Step(float current, float target, float seconds)
+    {
+        float change = target - current;
+        float limit = -1;
+        if (slewLimit > 0)
+            limit = slewLimit * seconds;
+
+        // Speeding up (same direction, faster - or from a stop)
+        if (accelerationLimit > 0 && fabs(target) > fabs(current) && target * current >= 0)
+        {
+            float accelerating = accelerationLimit * seconds;
+            if (limit < 0 || accelerating < limit)
+                limit = accelerating;
+        }
+
+        if (limit < 0 || fabs(change) <= limit)
+            return target;
+        return current + (change > 0 ? limit : -limit);
+    }
+
+    void Apply(float leftFraction, float rightFraction)
+    {
+        // Re-sent whenever the percent changes, which is also whenever the battery compensation does
+        float newLeftPercent = LEFT_MOTOR_PERCENT * compensateForBattery(leftMotorMap.Power(leftFraction));
+        float newRightPercent = RIGHT_MOTOR_PERCENT * compensateForBattery(rightMotorMap.Power(rightFraction));
+        if (newLeftPercent != leftPercent || lastUpdate < 0)
+        {
+            if (newLeftPercent == 0)
+                leftWheel.Stop();
+            else
+                leftWheel.SetPercent(newLeftPercent);
+        }
+        if (newRightPercent != rightPercent || lastUpdate < 0)
+        {
+            if (newRightPercent == 0)
+                rightWheel.Stop();
+            else
+                rightWheel.SetPercent(newRightPercent);
+        }
+
+        left = leftFraction;
+        right = rightFraction;
+        leftPercent = newLeftPercent;
+        rightPercent = newRightPercent;
+        robot.leftMotorPercent = leftPercent;
+        robot.rightMotorPercent = rightPercent;
+        lastUpdate = timeNow();
+
+        // Only worth waking up the drive task while there's still somewhere to get to
+        PeriodicTask &task = periodicTasks[DRIVE_TASK];
+        if (!task.isEnabled && !IsSettled())
+            task.nextRelease = lastUpdate + task.period;
+        task.isEnabled = !IsSettled();
+    }
+};
+
+ROBOT_STATE Drive drive(robot.hardware.leftMotor, robot.hardware.rightMotor);
+
+/**
+ * @brief stepDrive is the drive's background task - Keeps the wheels heading towards their targets between commands.
+ */
+void stepDrive() { drive.Update(); }
+
+#endif // DRIVE_H
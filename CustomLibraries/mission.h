@@ -0,0 +1,373 @@
+#ifndef MISSION_H
+#define MISSION_H
+
+// FEH Libraries
+#include <FEHLCD.h>
+#include <FEHSD.h>
+
+// C/C++ Libraries
+#include <stdlib.h>
+#include <string.h>
+
+// Custom Libraries
+#include "arm.h"
+#include "constants.h"
+#include "ddrlight.h"
+#include "pathplanner.h"
+#include "posepath.h"
+#include "recording.h"
+
+/*
+ * Mission scripts. If there's a MISSION_FILE on the SD card, main() runs it instead of finalRoutine, so the sequence and
+ * the waypoints can be changed between runs without rebuilding and reflashing.
+ *
+ * loadMission() reads it once at startup into a fixed-size table of steps (no heap - Everything's in the static arrays
+ * below), and runMission() goes through the table one step at a time, logging how long every step took.
+ *
+ * One step per line, a word for what it does and then its arguments:
+ *
+ *   goto X Y MODE                  goToPoint, no end heading
+ *   path X Y MODE                  goToPointPlanned - Same, but around anything in the way
+ *   pose X Y HEADING REVERSE MODE  goToPose - Curves in so it gets there facing HEADING (REVERSE 1 lets it back up)
+ *   turn HEADING                   turn()
+ *   precise HEADING                turnToAngleWhenAlreadyReallyClose()
+ *   servo DEGREE SECONDS           Arm to DEGREE, held there for SECONDS
+ *   drive LEFT RIGHT SECONDS       Each motor at a fraction of full power (negative is backwards) for SECONDS, no RPS
+ *   wait SECONDS                   Sleep()
+ *   light LABEL                    Jumps to LABEL if the DDR light is blue, otherwise keeps going - Only reads it if
+ *                                  it hasn't been read yet this run
+ *   jump LABEL                     Jumps to LABEL
+ *   label NAME                     Somewhere to jump to - Doesn't do anything itself
+ *   # ...                          Comment, to the end of the line
+ *
+ * Anywhere a number goes, it can also be a calibrated station, with or without an offset - TOKEN_X, LEVER_Y-4, DDR_X+2.
+ * Those get looked up when the step runs, so the script can be loaded before calibrate().
+ *
+ * If RPS gets lost for good partway through, the rest of the script gets skipped down to the "lost" label, if there is one.
+ * Anything wrong with the file (unknown step, bad number, missing label, too many steps) means none of it gets used, and
+ * the run falls back on finalRoutine.
+ */
+
+#define MISSION_FILE "MISSION.TXT"
+#define MISSION_MAX_STEPS 64
+#define MISSION_MAX_ARGUMENTS 5
+#define MISSION_WORD_LENGTH 32
+#define MISSION_WORD_FORMAT "%31s"      // Has to leave room for the end of the string in MISSION_WORD_LENGTH
+#define MISSION_LOST_LABEL "lost"
+
+// Every kind of step - Order has to match MISSION_STEP_TYPES
+enum { STEP_GOTO, STEP_PATH, STEP_POSE, STEP_TURN, STEP_PRECISE, STEP_SERVO, STEP_DRIVE, STEP_WAIT, STEP_LIGHT, STEP_JUMP, STEP_LABEL, STEP_TYPE_COUNT };
+
+struct MissionStepType
+{
+    const char *name;
+    int numberCount;        // How many numbers come after it
+    bool hasLabel;          // Whether a label comes after it instead
+};
+
+const MissionStepType MISSION_STEP_TYPES[STEP_TYPE_COUNT] =
+{
+    { "goto", 3, false },
+    { "path", 3, false },
+    { "pose", 5, false },
+    { "turn", 1, false },
+    { "precise", 1, false },
+    { "servo", 2, false },
+    { "drive", 3, false },
+    { "wait", 1, false },
+    { "light", 0, true },
+    { "jump", 0, true },
+    { "label", 0, true }
+};
+
+// A station a number can be relative to
+struct MissionStation
+{
+    const char *name;
+    float Calibration::*value;      // Which of robot.calibration it is
+};
+
+const MissionStation MISSION_STATIONS[] =
+{
+    { "TOKEN_X", &Calibration::tokenX }, { "TOKEN_Y", &Calibration::tokenY }, { "TOKEN_HEADING", &Calibration::tokenHeading },
+    { "DDR_X", &Calibration::ddrBlueLightX }, { "DDR_Y", &Calibration::ddrLightY },
+    { "RPS_BUTTON_X", &Calibration::rpsButtonX }, { "RPS_BUTTON_Y", &Calibration::rpsButtonY }, { "RPS_BUTTON_HEADING", &Calibration::rpsButtonHeading },
+    { "FOOSBALL_X", &Calibration::foosballStartX }, { "FOOSBALL_Y", &Calibration::foosballStartY },
+    { "LEVER_X", &Calibration::leverX }, { "LEVER_Y", &Calibration::leverY }, { "LEVER_HEADING", &Calibration::leverHeading }
+};
+const int MISSION_STATION_COUNT = sizeof(MISSION_STATIONS) / sizeof(MISSION_STATIONS[0]);
+
+// A number in a step - A station (or nothing) plus an offset
+struct MissionValue
+{
+    float Calibration::*station;
+    float offset;
+
+    float Get() const { return (station ? robot.calibration.*station : 0) + offset; }
+};
+
+struct MissionStep
+{
+    int type;
+    MissionValue values[MISSION_MAX_ARGUMENTS];
+    char label[MISSION_WORD_LENGTH];
+    int target;             // Step a light/jump goes to, once the labels are all read in
+};
+
+ROBOT_STATE MissionStep missionSteps[MISSION_MAX_STEPS];
+ROBOT_STATE float missionStepSeconds[MISSION_MAX_STEPS];
+ROBOT_STATE int missionStepCount = 0;
+
+/**
+ * @brief parseMissionValue reads a number, a station name, or a station name plus/minus a number.
+ * @return Whether it made sense.
+ */
+bool parseMissionValue(const char *word, MissionValue &value)
+{
+    char *end;
+    value.station = 0;
+    value.offset = strtod(word, &end);
+    if (end != word && *end == '\0')
+        return true;
+
+    // Station name, up to a + or - (if there is one)
+    int nameLength = strcspn(word, "+-");
+    for (int i = 0; i < MISSION_STATION_COUNT; i++)
+    {
+        if ((int) strlen(MISSION_STATIONS[i].name) != nameLength || strncmp(word, MISSION_STATIONS[i].name, nameLength) != 0)
+            continue;
+
+        value.station = MISSION_STATIONS[i].value;
+        if (word[nameLength] == '\0')
+        {
+            value.offset = 0;
+            return true;
+        }
+
+        value.offset = strtod(word + nameLength, &end);
+        return end != word + nameLength && *end == '\0';
+    }
+    return false;
+}
+
+// Step index of a label, or -1 if there isn't one by that name
+int findMissionLabel(const char *name)
+{
+    for (int i = 0; i < missionStepCount; i++)
+        if (missionSteps[i].type == STEP_LABEL && strcmp(missionSteps[i].label, name) == 0)
+            return i;
+    return -1;
+}
+
+/**
+ * @brief loadMission reads MISSION_FILE off of the SD card into missionSteps, if it's there.
+ * @return Whether there's a mission to run (otherwise missionStepCount is 0).
+ */
+bool loadMission()
+{
+    missionStepCount = 0;
+    FEHFile *file = SD.FOpen(MISSION_FILE, "r");
+    if (!file)
+    {
+        SD.Printf("Mission: No %s, running the built-in routine.\r\n", MISSION_FILE);
+        return false;
+    }
+
+    bool isValid = true;
+    char word[MISSION_WORD_LENGTH];
+    while (isValid && SD.FScanf(file, MISSION_WORD_FORMAT, word) == 1)
+    {
+        // Comments go to the end of the line
+        if (word[0] == '#')
+        {
+            SD.FScanf(file, "%*[^\n]");
+            continue;
+        }
+
+        int type = 0;
+        while (type < STEP_TYPE_COUNT && strcmp(word, MISSION_STEP_TYPES[type].name) != 0)
+            type++;
+        if (type == STEP_TYPE_COUNT)
+        {
+            SD.Printf("Mission: Step %d - Don't know what \"%s\" is.\r\n", missionStepCount, word);
+            isValid = false;
+            break;
+        }
+        if (missionStepCount == MISSION_MAX_STEPS)
+        {
+            SD.Printf("Mission: More than %d steps.\r\n", MISSION_MAX_STEPS);
+            isValid = false;
+            break;
+        }
+
+        MissionStep &step = missionSteps[missionStepCount];
+        step.type = type;
+        step.label[0] = '\0';
+        step.target = -1;
+
+        for (int i = 0; i < MISSION_STEP_TYPES[type].numberCount; i++)
+        {
+            if (SD.FScanf(file, MISSION_WORD_FORMAT, word) != 1)
+            {
+                SD.Printf("Mission: Step %d (%s) - Missing number %d of %d.\r\n", missionStepCount, MISSION_STEP_TYPES[type].name,
+                          i + 1, MISSION_STEP_TYPES[type].numberCount);
+                isValid = false;
+                break;
+            }
+            if (!parseMissionValue(word, step.values[i]))
+            {
+                SD.Printf("Mission: Step %d (%s) - Bad number \"%s\".\r\n", missionStepCount, MISSION_STEP_TYPES[type].name, word);
+                isValid = false;
+                break;
+            }
+        }
+        if (MISSION_STEP_TYPES[type].hasLabel && SD.FScanf(file, MISSION_WORD_FORMAT, step.label) != 1)
+        {
+            SD.Printf("Mission: Step %d (%s) - Missing its label.\r\n", missionStepCount, MISSION_STEP_TYPES[type].name);
+            isValid = false;
+        }
+
+        missionStepCount++;
+    }
+    SD.FClose(file);
+
+    // Jumps can go forwards, so they only get matched up with their labels once everything's read in
+    for (int i = 0; isValid && i < missionStepCount; i++)
+    {
+        MissionStep &step = missionSteps[i];
+        if (step.type != STEP_LIGHT && step.type != STEP_JUMP)
+            continue;
+
+        step.target = findMissionLabel(step.label);
+        if (step.target == -1)
+        {
+            SD.Printf("Mission: Step %d (%s) - No label \"%s\".\r\n", i, MISSION_STEP_TYPES[step.type].name, step.label);
+            isValid = false;
+        }
+    }
+
+    if (!isValid)
+    {
+        SD.Printf("Mission: Not using %s, running the built-in routine.\r\n", MISSION_FILE);
+        missionStepCount = 0;
+        return false;
+    }
+
+    SD.Printf("Mission: Loaded %d steps from %s.\r\n", missionStepCount, MISSION_FILE);
+    return true;
+}
+
+/**
+ * @brief runMissionStep does one step.
+ * @return The step to go to next.
+ */
+int runMissionStep(int index)
+{
+    const MissionStep &step = missionSteps[index];
+    const MissionValue *values = step.values;
+
+    switch (step.type)
+    {
+    case STEP_GOTO:
+        goToPoint(values[0].Get(), values[1].Get(), false, 0.0, false, 0.0, false, (int) values[2].Get());
+        break;
+
+    case STEP_PATH:
+        goToPointPlanned(values[0].Get(), values[1].Get(), false, 0.0, (int) values[2].Get());
+        break;
+
+    case STEP_POSE:
+        goToPose(values[0].Get(), values[1].Get(), values[2].Get(), values[3].Get() != 0, (int) values[4].Get());
+        break;
+
+    case STEP_TURN:
+        turn(values[0].Get());
+        break;
+
+    case STEP_PRECISE:
+        turnToAngleWhenAlreadyReallyClose(values[0].Get());
+        break;
+
+    case STEP_SERVO:
+        moveArm(values[0].Get(), 0, values[1].Get());
+        waitForArm();
+        break;
+
+    case STEP_DRIVE:
+        drive.SetWheels(values[0].Get(), values[1].Get());
+        schedulerSleep(values[2].Get());
+        drive.Stop();
+        break;
+
+    case STEP_WAIT:
+        Sleep(values[0].Get());
+        break;
+
+    case STEP_LIGHT:
+    {
+        // Only reads it the first time, after that (or after a checkpoint) it goes by what was read
+        if (ddrLightColor == -1)
+        {
+            float reading = robot.hardware.lightSensor.Value();
+            SD.Printf("Mission: Light reads %f.\r\n", reading);
+            ddrLightColor = isRedLightReading(reading) ? DDR_RED : DDR_BLUE;
+        }
+        else
+            SD.Printf("Mission: Light was already %s.\r\n", ddrLightColor == DDR_RED ? "red" : "blue");
+        if (ddrLightColor == DDR_BLUE)
+            return step.target;
+        break;
+    }
+
+    case STEP_JUMP:
+        return step.target;
+    }
+    return index + 1;
+}
+
+/**
+ * @brief runMission runs the loaded mission from the top, in place of finalRoutine.
+ */
+void runMission()
+{
+    int lostIndex = findMissionLabel(MISSION_LOST_LABEL);
+    bool hasSkippedToLost = false;
+    int stepsRun = 0;
+
+    for (int i = 0; i < missionStepCount; i++)
+        missionStepSeconds[i] = 0;
+
+    int index = 0;
+    while (index >= 0 && index < missionStepCount)
+    {
+        // Jumping backwards is allowed, but a script that loops forever shouldn't keep the robot from ever stopping
+        if (++stepsRun > 4 * MISSION_MAX_STEPS)
+        {
+            SD.Printf("Mission: Ran %d steps, giving up.\r\n", stepsRun - 1);
+            break;
+        }
+
+        if (robot.hasExhaustedDeadzone && lostIndex > index && !hasSkippedToLost)
+        {
+            SD.Printf("Mission: Lost RPS, skipping to step %d.\r\n", lostIndex);
+            hasSkippedToLost = true;
+            index = lostIndex;
+        }
+
+        double startTime = timeNow();
+        int next = runMissionStep(index);
+        float seconds = timeNow() - startTime;
+
+        missionStepSeconds[index] += seconds;
+        SD.Printf("Mission: Step %d (%s) took %f s.\r\n", index, MISSION_STEP_TYPES[missionSteps[index].type].name, seconds);
+        index = next;
+    }
+
+    // Every step's total, for tuning the script
+    SD.Printf("Mission: Done.\r\n");
+    for (int i = 0; i < missionStepCount; i++)
+        if (missionSteps[i].type != STEP_LABEL)
+            SD.Printf("Mission: %2d %-8s %f s\r\n", i, MISSION_STEP_TYPES[missionSteps[i].type].name, missionStepSeconds[i]);
+}
+
+#endif // MISSION_H
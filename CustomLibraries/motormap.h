@@ -0,0 +1,247 @@
+#ifndef MOTORMAP_H
+#define MOTORMAP_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "constants.h"
+#include "conversions.h"
+#include "drive.h"
+#include "scheduler.h"
+
+/*
+ * Motor map fitting. Our right motor is a little faster than the left one, so a straight command curves off to the left
+ * and goToPoint spends most of a straight line correcting for it. The MotorMaps in drive.h undo that - This is where they
+ * come from.
+ *
+ * fitMotorMaps() drives straight forwards and backwards at two powers and watches RPS the whole time. How fast the robot
+ * goes says how fast the wheels went together, and how fast it turns says how far apart they were, so that's both wheels'
+ * speeds at both powers in both directions. A straight line through each pair gives that wheel's deadband and how fast it
+ * speeds up after that. Then every wheel gets scaled down to the slowest one's top speed, so full power on any wheel in
+ * either direction is the same speed.
+ *
+ * calibrate() runs the fit when there's no MOTOR_MAP_FILE on the SD card, and saves it for every run after. Delete the file
+ * to fit them again (new motors, treads, etc.). Replays read it from the working directory, same as TASKSTAT.TXT.
+ */
+
+#define MOTOR_MAP_FILE "MOTORMAP.TXT"
+#define MOTOR_FIT_SETTLE_TIME .3    // Seconds at each power before measuring, for the wheels to get up to speed
+#define MOTOR_FIT_MEASURE_TIME .8   // Seconds measured at each power
+#define MOTOR_FIT_SAMPLE_TIME .02   // Seconds between RPS samples
+#define MOTOR_FIT_MAX_DEADBAND .3   // Anything past this is a bad fit, not a real deadband
+
+// The two powers it drives at - Far enough apart for a decent line, and the fast one still only takes ~15 inches
+const float MOTOR_FIT_LOW_POWER = .4, MOTOR_FIT_HIGH_POWER = .8;
+
+// Whether the maps in drive.h came off of the SD card (false means they still need fitted)
+ROBOT_STATE bool areMotorMapsFitted = false;
+
+/**
+ * @brief loadMotorMaps reads the fitted motor maps off of the SD card, if there are any.
+ */
+void loadMotorMaps()
+{
+    FEHFile *file = SD.FOpen(MOTOR_MAP_FILE, "r");
+    if (!file)
+    {
+        SD.Printf("Motor Map: No %s, motors will need fitted.\r\n", MOTOR_MAP_FILE);
+        return;
+    }
+
+    MotorMap *maps[] = { &leftMotorMap, &rightMotorMap };
+    int loaded = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        MotorMap &map = *maps[i];
+        if (SD.FScanf(file, "%f %f %f %f", &map.forwardDeadband, &map.forwardGain, &map.backwardDeadband, &map.backwardGain) != 4)
+            break;
+        loaded++;
+    }
+    SD.FClose(file);
+
+    // Half of a map is worse than none
+    if (loaded < 2)
+    {
+        SD.Printf("Motor Map: %s is incomplete, motors will need fitted.\r\n", MOTOR_MAP_FILE);
+        leftMotorMap = rightMotorMap = UNFITTED_MOTOR_MAP;
+        return;
+    }
+
+    areMotorMapsFitted = true;
+    SD.Printf("Motor Map: Left %f %f %f %f, Right %f %f %f %f\r\n", leftMotorMap.forwardDeadband, leftMotorMap.forwardGain,
+              leftMotorMap.backwardDeadband, leftMotorMap.backwardGain, rightMotorMap.forwardDeadband, rightMotorMap.forwardGain,
+              rightMotorMap.backwardDeadband, rightMotorMap.backwardGain);
+}
+
+/**
+ * @brief saveMotorMaps writes the motor maps to the SD card for next time.
+ */
+void saveMotorMaps()
+{
+    FEHFile *file = SD.FOpen(MOTOR_MAP_FILE, "w");
+    if (!file)
+    {
+        SD.Printf("Motor Map: Couldn't write %s.\r\n", MOTOR_MAP_FILE);
+        return;
+    }
+
+    MotorMap *maps[] = { &leftMotorMap, &rightMotorMap };
+    for (int i = 0; i < 2; i++)
+        SD.FPrintf(file, "%f %f %f %f\r\n", maps[i]->forwardDeadband, maps[i]->forwardGain, maps[i]->backwardDeadband, maps[i]->backwardGain);
+    SD.FClose(file);
+}
+
+// Least-squares line through some number against time - Only the slope and the average get used
+struct SlopeFit
+{
+    int count;
+    double sumTime, sumTimeSquared, sumValue, sumTimeValue;
+
+    SlopeFit() : count(0), sumTime(0), sumTimeSquared(0), sumValue(0), sumTimeValue(0) {}
+
+    void Add(double time, double value)
+    {
+        count++;
+        sumTime += time;
+        sumTimeSquared += time * time;
+        sumValue += value;
+        sumTimeValue += time * value;
+    }
+
+    float Slope() const { return (count * sumTimeValue - sumTime * sumValue) / (count * sumTimeSquared - sumTime * sumTime); }
+    float Average() const { return sumValue / count; }
+};
+
+/**
+ * @brief measureWheelSpeeds drives straight at the given power (negative for backwards) and works out how fast each wheel
+ * really went from what RPS saw, in inches per second.
+ * @return Whether RPS saw enough of it to tell.
+ */
+bool measureWheelSpeeds(float power, float &leftSpeed, float &rightSpeed)
+{
+    drive.Set(power, 0);
+    schedulerSleep(MOTOR_FIT_SETTLE_TIME);
+
+    SlopeFit x, y, turned;
+    float startHeading = -1;
+    double startTime = timeNow();
+    while (timeNow() - startTime < MOTOR_FIT_MEASURE_TIME)
+    {
+        float sampleX = rpsX(), sampleY = rpsY(), sampleHeading = rpsHeading();
+        if (sampleX >= 0 && sampleY >= 0 && sampleHeading >= 0)
+        {
+            if (startHeading < 0)
+                startHeading = sampleHeading;
+
+            double time = timeNow() - startTime;
+            x.Add(time, sampleX);
+            y.Add(time, sampleY);
+            turned.Add(time, fmod(sampleHeading - startHeading + 540, 360) - 180);
+        }
+        schedulerSleep(MOTOR_FIT_SAMPLE_TIME);
+    }
+
+    // Stopping all the way so the next power starts from rest
+    drive.Stop();
+    schedulerSleep(MOTOR_FIT_SETTLE_TIME);
+
+    if (x.count < 5)
+    {
+        SD.Printf("Motor Map: Only %d RPS samples at %f power.\r\n", x.count, power);
+        return false;
+    }
+
+    // Speed along the way it was facing, and how fast it turned (left wheel slower = turning left)
+    float heading = degreeToRadian(startHeading + turned.Average());
+    float speed = x.Slope() * cos(heading) + y.Slope() * sin(heading);
+    float turnRate = degreeToRadian(turned.Slope());
+    leftSpeed = speed - turnRate * TRACK_WIDTH / 2;
+    rightSpeed = speed + turnRate * TRACK_WIDTH / 2;
+
+    SD.Printf("Motor Map: At %f power, left wheel %f in/s, right wheel %f in/s.\r\n", power, leftSpeed, rightSpeed);
+    return true;
+}
+
+// Fits speed = slope * (power - deadband) through one wheel's speeds at the two fit powers (in one direction, so both positive)
+bool fitWheel(float lowSpeed, float highSpeed, float &slope, float &deadband)
+{
+    slope = (highSpeed - lowSpeed) / (MOTOR_FIT_HIGH_POWER - MOTOR_FIT_LOW_POWER);
+    if (lowSpeed <= 0 || slope <= 0)
+        return false;
+
+    deadband = MOTOR_FIT_LOW_POWER - lowSpeed / slope;
+    if (deadband < 0)
+        deadband = 0;
+    return deadband <= MOTOR_FIT_MAX_DEADBAND;
+}
+
+/**
+ * @brief fitMotorMaps runs the calibration drive and fits both motor maps from it (see the top of this file). Needs about
+ * 15 inches of open space in front of and behind the robot, and RPS. Leaves the old maps alone if the fit doesn't work out.
+ * @return Whether it got a fit.
+ */
+bool fitMotorMaps()
+{
+    SD.Printf("Motor Map: Fitting the motors.\r\n");
+    MotorMap oldLeft = leftMotorMap, oldRight = rightMotorMap;
+    leftMotorMap = rightMotorMap = UNFITTED_MOTOR_MAP;
+
+    // Forwards then backwards at each power, so it ends up about where it started
+    // [wheel][direction][power] - Left/right, forwards/backwards, low/high
+    float speeds[2][2][2];
+    const float powers[2] = { MOTOR_FIT_LOW_POWER, MOTOR_FIT_HIGH_POWER };
+    bool isMeasured = true;
+    for (int power = 0; power < 2 && isMeasured; power++)
+    {
+        for (int direction = 0; direction < 2 && isMeasured; direction++)
+        {
+            isMeasured = measureWheelSpeeds(direction == 0 ? powers[power] : -powers[power], speeds[0][direction][power], speeds[1][direction][power]);
+            speeds[0][direction][power] = fabs(speeds[0][direction][power]);
+            speeds[1][direction][power] = fabs(speeds[1][direction][power]);
+        }
+    }
+
+    // Each wheel's line in each direction, and the slowest top speed out of all of them
+    float slopes[2][2], deadbands[2][2];
+    float topSpeed = -1;
+    for (int wheel = 0; wheel < 2 && isMeasured; wheel++)
+    {
+        for (int direction = 0; direction < 2 && isMeasured; direction++)
+        {
+            isMeasured = fitWheel(speeds[wheel][direction][0], speeds[wheel][direction][1], slopes[wheel][direction], deadbands[wheel][direction]);
+            float wheelTopSpeed = slopes[wheel][direction] * (1 - deadbands[wheel][direction]);
+            if (topSpeed < 0 || wheelTopSpeed < topSpeed)
+                topSpeed = wheelTopSpeed;
+        }
+    }
+
+    if (!isMeasured)
+    {
+        SD.Printf("Motor Map: Couldn't fit the motors, keeping the old maps.\r\n");
+        leftMotorMap = oldLeft;
+        rightMotorMap = oldRight;
+        return false;
+    }
+
+    // Top speed on every wheel is the slowest one's, so the gain is how much of its own line that takes
+    MotorMap *maps[] = { &leftMotorMap, &rightMotorMap };
+    for (int wheel = 0; wheel < 2; wheel++)
+    {
+        maps[wheel]->forwardDeadband = deadbands[wheel][0];
+        maps[wheel]->forwardGain = topSpeed / slopes[wheel][0];
+        maps[wheel]->backwardDeadband = deadbands[wheel][1];
+        maps[wheel]->backwardGain = topSpeed / slopes[wheel][1];
+    }
+
+    areMotorMapsFitted = true;
+    SD.Printf("Motor Map: Top speed %f in/s. Left %f %f %f %f, Right %f %f %f %f\r\n", topSpeed, leftMotorMap.forwardDeadband,
+              leftMotorMap.forwardGain, leftMotorMap.backwardDeadband, leftMotorMap.backwardGain, rightMotorMap.forwardDeadband,
+              rightMotorMap.forwardGain, rightMotorMap.backwardDeadband, rightMotorMap.backwardGain);
+    return true;
+}
+
+#endif // MOTORMAP_H
@@ -7,7 +7,12 @@
 #include <FEHRPS.h>
 
 // Custom Libraries
+#include "course.h"
+#include "deadline.h"
+#include "drive.h"
+#include "odometry.h"
 #include "rps.h"
+#include "stall.h"
 #include "utility.h"
 
 void getBackToRPSFromDeadzone();
@@ -18,27 +23,111 @@ void turnNoRPS(float currentHeading, float endHeading);
 // Removes need to prefix lots of function calls with std
 using namespace std;
 
-#define GOTOPOINT_COUNTS_PER_SECOND 10
+/**
+ * @brief NavigationTuning holds every threshold and timing that goToPoint, turn, and the precise turns work off of.
+ * They all interact, so they live in one place - Simulator/tune.cpp searches over this struct and prints a new one to paste in below.
+ */
+struct NavigationTuning
+{
+    // goToPoint
+    float correctionBand;           // Degrees off the desired heading before goToPoint starts correcting
+    float majorCorrectionBand;      // Degrees off before goToPoint gives up correcting, stops, and re-turns
+    float largeCorrectionBand;      // Degrees off before a correction counts as "large" instead of "small"
+    float smallCorrectionScale;     // Inside wheel's share of the power during a small correction
+    float largeCorrectionScale;     // Inside wheel's share of the power during a large correction
+    float slowDownDistance;         // Inches from the point where goToPoint drops to its slower speed
+    float controlLoopSleep;         // Seconds between the starts of goToPoint iterations (see scheduler.h)
+
+    // turn
+    float turnTolerance;            // Degrees off that turn() is satisfied with
+    float turnFastBand;             // Degrees off before a left turn goes at full speed
+    float turnMediumBand;           // Degrees off before a left turn goes at medium speed
+    float turnRightFastBand;        // Degrees off before a right turn goes at full speed
+
+    // turnToAngleWhenKindaClose & turnToAngleWhenAlreadyReallyClose
+    float kindaCloseTolerance;      // Degrees off that turnToAngleWhenKindaClose is satisfied with
+    float reallyCloseTolerance;     // Degrees off that turnToAngleWhenAlreadyReallyClose is satisfied with
+    float kindaClosePulse;          // Seconds each kinda-close turning pulse lasts
+    float reallyClosePulse;         // Seconds each really-close turning pulse lasts
+    float pulseSettleTime;          // Seconds to wait after a pulse so RPS catches up
+};
+
+// Hand-tuned on the course - See the comments in the struct for what each one does
+ROBOT_STATE NavigationTuning tuning =
+{
+    3, 30, 15, .5, .3, 4, .025,
+    8, 50, 25, 40,
+    5, 1.5, .15, .075, .34
+};
+
+// Every pass through a control loop (goToPoint, turn, and the precise turns) adds one - Handy for seeing where the loop time goes
+ROBOT_STATE unsigned long controlIterations = 0;
+
+// Longest each blocking loop keeps trying before it gives up and moves on, in seconds. Way longer than any of them should
+// ever take - These are only here so one bad RPS reading or a wedged wheel can't eat the whole run.
+#define GOTOPOINT_TIMEOUT 20
+#define TURN_TIMEOUT 6
+#define PRECISE_TURN_TIMEOUT 4
+#define DEADZONE_ESCAPE_TIMEOUT 4
+
+/*
+ * goToPoint's policies. Which way it drives, whether it's on a clock, and how fast it goes never change partway through a
+ * call, so they're template parameters instead of arguments - Each combination gets its own copy of goToPoint with its
+ * speeds and tolerance folded into constants, and the control loop only branches on things that really do change (how far
+ * off the heading is and which way).
+ */
+
+// Which way goToPoint drives to its point - SIGN goes on every motor power, Facing() is the heading that drives towards
+// a point that's "towards" degrees away
+struct Forwards
+{
+    static const int SIGN = 1;
+    static float Facing(float towards) { return towards; }
+};
+
+// We only go backwards during foosball (and goToPose's fallback, when it's allowed to reverse)
+struct Backwards
+{
+    static const int SIGN = -1;
+    static float Facing(float towards) { return rotate180Degrees(towards); }
+};
+
+// Untimed gives up after GOTOPOINT_TIMEOUT. Timed gives up after the time it's passed, and creeps along at .2 whenever it's
+// lined up - All instances where we have timed loops are where we want slow speeds (this was here for DDR)
+struct Untimed { static const bool IS_TIMED = false; };
+struct Timed { static const bool IS_TIMED = true; };
+
+// How fast goToPoint goes and how close it has to get, by the old mode number - 0 for fine positioning, 2 for "Just get there
+// fast and don't worry too much about precision", and on up from there (5 is the ramp, 6 the long hauls to the lever and end)
+template <int MODE>
+struct SpeedProfile
+{
+    static float Cruise() { return .2 + (MODE * .1); }              // Lined up and farther than slowDownDistance away
+    static float Approach() { return .2 + (MODE * .05); }           // Lined up and closer than that
+    static float Tolerance() { return .75 + (MODE * .25); }         // Faster modes mean we care less about being precise
+};
+
+typedef SpeedProfile<0> SlowSpeed;
+typedef SpeedProfile<2> FastSpeed;
+typedef SpeedProfile<5> RampSpeed;
 
 /*
  *
  * Oh boy, is this a fun method...
  *
  * @brief goToPoint, long story short, takes in an (x, y) coordinate and makes its way there, intelligently autocorrecting so that it automatically gets to within a very small tolerance of that point.
+ * Direction (Forwards/Backwards), Timing (Untimed/Timed) and Speed (a SpeedProfile) pick the instance - e.g. goToPoint<Forwards, Untimed, SlowSpeed>(x, y).
  * @param endX is the x-coordinate of the point you want the robot to go to.
  * @param endY is the y-coordinate of the point you want the robot to go to.
  * @param shouldTurnToEndHeading is a boolean representing whether or not the robot should turn to a passed-in heading all the way at the end. Mostly used for task positioning.
  * @param endHeading is the endHeading mentioned from the last parameter.
- * @param isTimed is a boolean representing whether or not the robot should exit this function after a specified amount of time has passed.
- * @param time is the time amount at which the function should be stopped if isTimed be true
- * @param shouldGoBackwards is a boolean representing whether or not the robot should go forwards during the travel phase or backwards. We only go backwards during foosball; Everywhere else is forwards.
- * @param mode is an integer set to 0 for "Slow", 1 for "Medium" and 2 for "Fast" speeds. Generally, we use 0 for fine positioning and
- * 2 for "Just get there fast and don't worry too much about precision", but 1 has intermediate uses.
+ * @param time is the time amount at which the function should be stopped, for the Timed instances
  *
  * This is the fun method. Have fun. I lost my sanity several times over trying to build a lot of this proportional stuff in, but it turned out pretty well in the end.
  *
  */
-void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHeading, bool isTimed, float time, bool shouldGoBackwards, int mode)
+template <class Direction, class Timing, class Speed>
+void goToPoint(float endX, float endY, bool shouldTurnToEndHeading = false, float endHeading = 0, float time = 0)
 {
     // If calibration really dropped the ball on this coordinate, skip it, basically
     if (endX == -1 && endY == -1)
@@ -50,18 +139,19 @@ void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHea
     SD.Printf("goToPoint: End (x, y): (%f, %f)\r\n", endX, endY);
     SD.Printf("goToPoint: Should Turn To End Heading (1 = Yes, 0 = No): %d\r\n", shouldTurnToEndHeading);
     SD.Printf("goToPoint: endHeading: %f\r\n", endHeading);
-    SD.Printf("goToPoint: Is Timed (1 = Yes, 0 = No): %d\r\n", isTimed);
+    SD.Printf("goToPoint: Is Timed (1 = Yes, 0 = No): %d\r\n", Timing::IS_TIMED);
     SD.Printf("goToPoint: Time: %f\r\n", time);
-    SD.Printf("goToPoint: Should Go Backwards (1 = Yes, 0 = No): %d\r\n", shouldGoBackwards);
+    SD.Printf("goToPoint: Should Go Backwards (1 = Yes, 0 = No): %d\r\n", Direction::SIGN < 0);
 
     // Ensures we go into turn() with valid RPS, and handles the case where we hit a deadzone during the RPS checks 
     // This is one of the weirder loops in the program, don't worry about how it works
-    if (loopUntilValidRPS() == -2)
+    int rpsWait = loopUntilValidRPS();
+    if (rpsWait == -2)
     {
         SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
         // Causes the program to skip certain goToPoint calls
-        hasExhaustedDeadzone = true;
+        robot.hasExhaustedDeadzone = true;
 
         // Does what you think it does
         SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -70,33 +160,34 @@ void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHea
         // Escapes this call of goToPoint because it doesn't really have RPS any more
         return;
     }
+    if (rpsWait == -1)
+    {
+        SD.Printf("goToPoint: No RPS, giving up on this one.\r\n");
+        return;
+    }
 
     SD.Printf("goToPoint: Entering initial alignment turn() function.\r\n");
 
-    // If it's supposed to turn forwards, just turn towards the point 
-    if (!shouldGoBackwards)
-        turn(endX, endY);
-    
-    // Otherwise, if it's supposed to turn backwards, turn to 180 degrees away from that point 
-    // Todo - Consider replacing RPS.X with lastValidX (and so on) throughout the code to always use the cached values (I don't think this is necessary, but could be a good sanity check)
-    else 
-        turn(rotate180Degrees(getDesiredHeading(RPS.X(), RPS.Y(), endX, endY))); // Todo - This statement could be cleaned up a bit logically 
+    // Turn towards the point (or 180 degrees away from it, going backwards)
+    // Todo - Consider replacing RPS.X with robot.lastValid (x and so on) throughout the code to always use the cached values (I don't think this is necessary, but could be a good sanity check)
+    turn(Direction::Facing(getDesiredHeading(rpsXToCentroidX(), rpsYToCentroidY(), endX, endY)));
 
     // Debug 
     SD.Printf("goToPoint: Entering distance tolerance check.\r\n");
     
     // Tolerance Loop Setup 
-    int iterationCount  = 0;
+    Deadline deadline(Timing::IS_TIMED ? time : GOTOPOINT_TIMEOUT);
     float desiredHeading;
 
     // Ensures we go into turn() with valid RPS, and handles the case where we hit a deadzone during the RPS checks
     // This is one of the weirder loops in the program, don't worry about how it works
-    if (loopUntilValidRPS() == -2)
+    rpsWait = loopUntilValidRPS();
+    if (rpsWait == -2)
     {
         SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
         // Causes the program to skip certain goToPoint calls
-        hasExhaustedDeadzone = true;
+        robot.hasExhaustedDeadzone = true;
 
         // Does what you think it does
         SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -105,279 +196,108 @@ void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHea
         // Escapes this call of goToPoint because it doesn't really have RPS any more
         return;
     }
+    if (rpsWait == -1)
+    {
+        SD.Printf("goToPoint: No RPS, giving up on this one.\r\n");
+        return;
+    }
 
     // Step #2 of Method - Go To The Point
-    float currentOverallMotorPower = .2 + (mode * .1); // Used to link turn speeds to forward speed
-    float tolerance = .75 + (mode * .25); // Faster modes mean we care less about being precise and that we can be satisifed with a higher tolerance
-    while (getDistance(rpsXToCentroidX(), rpsYToCentroidY(), endX, endY) > tolerance)
+    float currentOverallMotorPower = Speed::Cruise(); // Used to link turn speeds to forward speed
+    ProgressMonitor progress("goToPoint", tuning.controlLoopSleep);
+    startTicks(GOTOPOINT_TICK, tuning.controlLoopSleep);
+    while (getDistance(rpsXToCentroidX(), rpsYToCentroidY(), endX, endY) > Speed::Tolerance())
     {
+        controlIterations++;
+
         // We're guaranteed to have good RPS here
         updateLastValidRPSValues();
 
-        // Timing check (this is basically the Proteus version of a timer using Sleep() method calls)
-        if (isTimed)
+        // Timing check - Goes off the clock, since an iteration can take longer than its tick when there's a lot of logging
+        if (Timing::IS_TIMED)
         {
-            SD.Printf("goToPoint: Current Iteration Count: %f\r\n", iterationCount);
-            SD.Printf("goToPoint: Max Iteration Count: %f\r\n", (time * GOTOPOINT_COUNTS_PER_SECOND));
-
-            iterationCount++;
-            if (iterationCount > (time * GOTOPOINT_COUNTS_PER_SECOND))
-            {
-                break;
-            }
+            SD.Printf("goToPoint: Seconds So Far: %f\r\n", deadline.SecondsElapsed());
+            SD.Printf("goToPoint: Max Seconds: %f\r\n", time);
+        }
+        if (deadline.HasPassed())
+        {
+            if (!Timing::IS_TIMED)
+                SD.Printf("goToPoint: Gave up on (%f, %f) after %d seconds.\r\n", endX, endY, GOTOPOINT_TIMEOUT);
+            break;
         }
 
-        if (!shouldGoBackwards)
-            desiredHeading = getDesiredHeading(rpsXToCentroidX(), rpsYToCentroidY(), endX, endY);
-        else
-            desiredHeading = rotate180Degrees(getDesiredHeading(rpsXToCentroidX(), rpsYToCentroidY(), endX, endY));
+        desiredHeading = Direction::Facing(getDesiredHeading(rpsXToCentroidX(), rpsYToCentroidY(), endX, endY));
 
         // Debug Output
-        SD.Printf("goToPoint: Current Position: (%f, %f).\r\n", RPS.X(), RPS.Y());
+        SD.Printf("goToPoint: Current Position: (%f, %f).\r\n", rpsX(), rpsY());
         SD.Printf("goToPoint: Intended Position: (%f, %f)\r\n", endX, endY);
-        SD.Printf("goToPoint: Current Heading: %f\r\n", RPS.Heading());
+        SD.Printf("goToPoint: Current Heading: %f\r\n", rpsHeading());
         SD.Printf("goToPoint: Desired Heading: %f\r\n", desiredHeading);
         SD.Printf("currentOverallMotorPower this iteration of the tolerance loop: %f\r\n", currentOverallMotorPower);
 
         /* DECISIONS, DECISIONS, ALL OF THEM WRONG */
         // Needs to autocorrect angularly this cycle
-        if (smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) > 3)
+        if (smallestDistanceBetweenHeadings(rpsHeading(), desiredHeading) > tuning.correctionBand)
         {
             // Can't feasibly correct in time, so it stops and turns
-            if (smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) >= 30)
+            if (smallestDistanceBetweenHeadings(rpsHeading(), desiredHeading) >= tuning.majorCorrectionBand)
             {
                 SD.Printf("goToPoint: Heading MAJORLY off. Stopping and re-turning.\r\n");
 
-                leftMotor.Stop();
-                currentLeftMotorPercent = 0;
+                drive.Stop();
 
-                rightMotor.Stop();
-                currentRightMotorPercent = 0;
-
-                turn(endX, endY);
+                turn(desiredHeading);
+                progress.Restart();
             }
 
-            // Forwards Corrections
-            if (!shouldGoBackwards)
-            {
-                // Left Correction
-                if (shouldTurnLeft(RPS.Heading(), desiredHeading))
-                {
-                    // Small Correction Necessary
-                    if (smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) >= 0 && smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) < 15)
-                    {
-                        SD.Printf("goToPoint: Given currentHeading = %f, endHeading = %f, turning slow-speed left to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * currentOverallMotorPower * .5);
-                        currentLeftMotorPercent = LEFT_MOTOR_PERCENT * currentOverallMotorPower * .5;
-
-                        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentRightMotorPercent = RIGHT_MOTOR_PERCENT * currentOverallMotorPower;
-                    }
-
-                    // Large Correction Necessary
-                    else
-                    {
-                        SD.Printf("goToPoint: Given currentHeading = %f, endHeading = %f, turning fast-speed left to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * currentOverallMotorPower * .3);
-                        currentLeftMotorPercent = LEFT_MOTOR_PERCENT * currentOverallMotorPower * .3;
-
-                        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentRightMotorPercent = RIGHT_MOTOR_PERCENT * currentOverallMotorPower;
-                    }
-                }
-
-                // Right Correction
-                else
-                {
-                    // Small Correction
-                    if (smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) >= 0 && smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) < 15)
-                    {
-                        SD.Printf("goToPoint: Given currentHeading = %f, endHeading = %f, turning slow-speed right to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentLeftMotorPercent = LEFT_MOTOR_PERCENT * currentOverallMotorPower;
-
-                        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .5);
-                        currentRightMotorPercent = RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .5;
-                    }
-
-                    // Large Correction
-                    else
-                    {
-                        SD.Printf("goToPoint: Given currentHeading = %f, endHeading = %f, turning fast-speed right to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentLeftMotorPercent = LEFT_MOTOR_PERCENT * currentOverallMotorPower;
-
-                        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .3);
-                        currentRightMotorPercent = RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .3;
-                    }
-                }
-            }
+            // Small correction slows the inside wheel down a little, large slows it down a lot
+            bool isLeft = shouldTurnLeft(rpsHeading(), desiredHeading);
+            bool isSmall = smallestDistanceBetweenHeadings(rpsHeading(), desiredHeading) < tuning.largeCorrectionBand;
+            SD.Printf("goToPoint: Given currentHeading = %f, endHeading = %f, turning %s %s to autocorrect.\r\n", rpsHeading(),
+                      desiredHeading, isSmall ? "slow-speed" : "fast-speed", isLeft ? "left" : "right");
 
-            // Backwards Corrections
+            // Going forwards, turning left means slowing the left wheel - Going backwards, it's the right one
+            float inside = currentOverallMotorPower * (isSmall ? tuning.smallCorrectionScale : tuning.largeCorrectionScale);
+            if (isLeft == (Direction::SIGN > 0))
+                drive.SetWheels(Direction::SIGN * inside, Direction::SIGN * currentOverallMotorPower);
             else
-            {
-                // Left Correction
-                if (shouldTurnLeft(RPS.Heading(), desiredHeading))
-                {
-                    // Small Correction
-                    if (smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) >= 0 && smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) < 15)
-                    {
-                        SD.Printf("goToPoint: (Going backwards) Given currentHeading = %f, endHeading = %f, turning slow-speed left to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * currentOverallMotorPower;
-
-                        rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .5);
-                        currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .5;
-                    }
-
-                    // Large Correction
-                    else
-                    {
-                        SD.Printf("goToPoint: (Going backwards) Given currentHeading = %f, endHeading = %f, turning fast-speed left to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * currentOverallMotorPower;
-
-                        rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .3);
-                        currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * currentOverallMotorPower * .3;
-                    }
-                }
-
-                // Right Correction
-                else
-                {
-                    // Small Correction
-                    if (smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) >= 0 && smallestDistanceBetweenHeadings(RPS.Heading(), desiredHeading) < 15)
-                    {
-                        SD.Printf("goToPoint: (Going backwards) Given currentHeading = %f, endHeading = %f, turning slow-speed right to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * currentOverallMotorPower * .5);
-                        currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * currentOverallMotorPower * .5;
-
-                        rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * currentOverallMotorPower;
-                    }
-
-                    // Large Correction
-                    else
-                    {
-                        SD.Printf("goToPoint: (Going backwards) Given currentHeading = %f, endHeading = %f, turning fast-speed right to autocorrect.\r\n", RPS.Heading(), desiredHeading);
-
-                        leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * currentOverallMotorPower * .3);
-                        currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * currentOverallMotorPower * .3;
-
-                        rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * currentOverallMotorPower);
-                        currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * currentOverallMotorPower;
-                    }
-                }
-            }
+                drive.SetWheels(Direction::SIGN * currentOverallMotorPower, Direction::SIGN * inside);
         }
 
-        // Otherwise, it can just go forward this cycle
+        // Otherwise, it can just go straight this cycle
         else
         {
-            // Forwards, No Turn
-            if (!shouldGoBackwards)
-            {
-                // This is basically a special case - All instances where we have timed loops are where we want slow speeds (this change is here for DDR)
-                if (isTimed)
-                {
-                    leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .2);
-                    currentLeftMotorPercent = .2;
-
-                    rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .2);
-                    currentRightMotorPercent = .2;
-
-                    currentOverallMotorPower = .2;
-                }
+            // This is basically a special case - All instances where we have timed loops are where we want slow speeds (this change is here for DDR)
+            if (Timing::IS_TIMED)
+                currentOverallMotorPower = .2;
 
-                // Long distance, fast speed
-                else if (getDistance(RPS.X(), RPS.Y(), endX, endY) > 4)
-                {                    
-                    SD.Printf("goToPoint: Robot is in line with desired angle, and is 4+ inches away. Going straight at full speed.\r\n");
-
-                    leftMotor.SetPercent(LEFT_MOTOR_PERCENT * (.2 + (mode * .1)));
-                    currentLeftMotorPercent = LEFT_MOTOR_PERCENT * (.2 + (mode * .1));
-
-                    rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * (.2 + (mode * .1)));
-                    currentRightMotorPercent = RIGHT_MOTOR_PERCENT * (.2 + (mode * .1));
-
-                    currentOverallMotorPower = (.2 + (mode * .1));
-                }
-
-                // Close distance, (relatively) low speed
-                else
-                {
-                    // TODO - Test this tuning; It might be a little high in order for tolerance to work as intended
-                    leftMotor.SetPercent(LEFT_MOTOR_PERCENT * (.2 + (mode * .05)));
-                    currentLeftMotorPercent = LEFT_MOTOR_PERCENT * (.2 + (mode * .05));
-
-                    rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * (.2 + (mode * .05)));
-                    currentRightMotorPercent = RIGHT_MOTOR_PERCENT * (.2 + (mode * .05));
+            // Long distance, fast speed
+            else if (getDistance(rpsX(), rpsY(), endX, endY) > tuning.slowDownDistance)
+            {
+                SD.Printf("goToPoint: Robot is in line with desired angle, and is 4+ inches away. Going straight at full speed.\r\n");
 
-                    currentOverallMotorPower = (.2 + (mode * .05));
-                }
+                currentOverallMotorPower = Speed::Cruise();
             }
 
-            // Backwards, No Turn
+            // Close distance, (relatively) low speed
+            // TODO - Test this tuning; It might be a little high in order for tolerance to work as intended
             else
-            {
-                // This is basically a special case - All instances where we have timed loops are where we want slow speeds (this change is here for DDR)
-                if (isTimed)
-                {
-                    leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .2);
-                    currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * .2;
+                currentOverallMotorPower = Speed::Approach();
 
-                    rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .2);
-                    currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * .2;
-
-                    currentOverallMotorPower = .2;
-                }
-
-                // Long distance, fast speed
-                else if (getDistance(RPS.X(), RPS.Y(), endX, endY) > 4)
-                {
-                    SD.Printf("goToPoint: Robot is in line with desired angle, and is 4+ inches away. Going straight at full speed.\r\n");
-
-                    leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * (.2 + (mode * .1)));
-                    currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * (.2 + (mode * .1));
-
-                    rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * (.2 + (mode * .1)));
-                    currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * (.2 + (mode * .1));
-
-                    currentOverallMotorPower = (.2 + (mode * .1));
-                }
-
-                // Close distance, (relatively) low speed
-                else
-                {
-                    // TODO - Test this tuning; It might be a little high in order for tolerance to work as intended
-                    leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * (.2 + (mode * .05)));
-                    currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * (.2 + (mode * .05));
-
-                    rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * (.2 + (mode * .05)));
-                    currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * (.2 + (mode * .05));
-
-                    currentOverallMotorPower = (.2 + (mode * .05));
-                }
-            }
+            drive.Set(Direction::SIGN * currentOverallMotorPower, 0);
         }
 
         // Post-Logic Debug
         SD.Printf("goToPoint: Finalized motor powers at end of tolerance loop: \r\n");
-        SD.Printf("goToPoint: Left Motor: %f\r\n", currentLeftMotorPercent);
-        SD.Printf("goToPoint: Right Motor: %f\r\n", currentRightMotorPercent);
+        SD.Printf("goToPoint: Left Motor: %f\r\n", robot.leftMotorPercent);
+        SD.Printf("goToPoint: Right Motor: %f\r\n", robot.rightMotorPercent);
 
         // Letting a little bit of time elapse before we test new stuff
-        Sleep(.025);
+        waitForTick(GOTOPOINT_TICK);
 
         // Ensures fresh RPS for next tolerance check and handles deadzone behavior
-        if (loopUntilValidRPS() == -2)
+        rpsWait = loopUntilValidRPS();
+        if (rpsWait == -2)
         {
             // Debug
             SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -386,21 +306,27 @@ void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHea
             getBackToRPSFromDeadzone();
 
             // Program will now skip the rest of the goToPoint calls up top
-            hasExhaustedDeadzone = true;
+            robot.hasExhaustedDeadzone = true;
 
             // Escapes this call of goToPoint because it doesn't really have RPS any more
             return;
         }
+        if (rpsWait == -1)
+        {
+            SD.Printf("goToPoint: No RPS, giving up on this one.\r\n");
+            return;
+        }
+
+        // Caught on something - Backs off, comes at it from a little to the side, and keeps going (see stall.h)
+        // Timed instances are there to creep up against things, so they don't count
+        if (!Timing::IS_TIMED && progress.IsStalled(robot.lastValid.x, robot.lastValid.y) && !recoverFromStall(progress, Direction::SIGN))
+            break;
     }
 
     SD.Printf("goToPoint: goToPoint is done; Stopping motors.\r\n");
 
     // Stopping the motors outright
-    leftMotor.Stop();
-    currentLeftMotorPercent = 0;
-
-    rightMotor.Stop();
-    currentRightMotorPercent = 0;
+    drive.Stop();
 
     // Step 3 Of Method - Turn to End Heading 
     if (shouldTurnToEndHeading)
@@ -413,12 +339,12 @@ void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHea
     SD.Printf("///////////////////////////////\r\n");
     SD.Printf("goToPoint: FUNCTION SYNOPSIS: \r\n");
     SD.Printf("goToPoint: Intended (x, y): (%f, %f)\r\n", endX, endY);
-    SD.Printf("goToPoint: Actual (x, y) @ End: (%f, %f)\r\n", RPS.X(), RPS.Y());
+    SD.Printf("goToPoint: Actual (x, y) @ End: (%f, %f)\r\n", rpsX(), rpsY());
 
     if (shouldTurnToEndHeading)
     {
         SD.Printf("goToPoint: Intended Heading: %f\r\n", endHeading);
-        SD.Printf("goToPoint: Actual Heading @ End: %f\r\n", RPS.Heading());
+        SD.Printf("goToPoint: Actual Heading @ End: %f\r\n", rpsHeading());
     }
 
     else
@@ -429,36 +355,67 @@ void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHea
     SD.Printf("///////////////////////////////\r\n");
 }
 
+// Picks the speed profile for goToPoint()'s run-time version
+template <class Direction, class Timing>
+void goToPointAtMode(float endX, float endY, bool shouldTurnToEndHeading, float endHeading, float time, int mode)
+{
+    switch (mode)
+    {
+        case 0: goToPoint<Direction, Timing, SpeedProfile<0> >(endX, endY, shouldTurnToEndHeading, endHeading, time); break;
+        case 1: goToPoint<Direction, Timing, SpeedProfile<1> >(endX, endY, shouldTurnToEndHeading, endHeading, time); break;
+        case 2: goToPoint<Direction, Timing, SpeedProfile<2> >(endX, endY, shouldTurnToEndHeading, endHeading, time); break;
+        case 3: goToPoint<Direction, Timing, SpeedProfile<3> >(endX, endY, shouldTurnToEndHeading, endHeading, time); break;
+        case 4: goToPoint<Direction, Timing, SpeedProfile<4> >(endX, endY, shouldTurnToEndHeading, endHeading, time); break;
+        case 5: goToPoint<Direction, Timing, SpeedProfile<5> >(endX, endY, shouldTurnToEndHeading, endHeading, time); break;
+        default:
+            SD.Printf("goToPoint: No mode %d, going at mode 6.\r\n", mode);
+            // Falls through
+        case 6: goToPoint<Direction, Timing, SpeedProfile<6> >(endX, endY, shouldTurnToEndHeading, endHeading, time); break;
+    }
+}
+
+/**
+ * @brief goToPoint's run-time version, for callers that only find out the direction and mode as they go (goToPose,
+ * goToPointPlanned, mission files). Same parameters as it's always had - Picks the instance and calls it.
+ * @param shouldGoBackwards is a boolean representing whether or not the robot should go forwards during the travel phase or backwards.
+ * @param mode is an integer from 0 ("Slow") on up (see SpeedProfile).
+ */
+void goToPoint(float endX, float endY, bool shouldTurnToEndHeading, float endHeading, bool isTimed, float time, bool shouldGoBackwards, int mode)
+{
+    if (shouldGoBackwards && isTimed)
+        goToPointAtMode<Backwards, Timed>(endX, endY, shouldTurnToEndHeading, endHeading, time, mode);
+    else if (shouldGoBackwards)
+        goToPointAtMode<Backwards, Untimed>(endX, endY, shouldTurnToEndHeading, endHeading, time, mode);
+    else if (isTimed)
+        goToPointAtMode<Forwards, Timed>(endX, endY, shouldTurnToEndHeading, endHeading, time, mode);
+    else
+        goToPointAtMode<Forwards, Untimed>(endX, endY, shouldTurnToEndHeading, endHeading, time, mode);
+}
+
 void getBackToRPSFromDeadzone()
 {
     // This should automatically be called regardless but setting it here too just incase
-    hasExhaustedDeadzone = true;
+    robot.hasExhaustedDeadzone = true;
 
-    // If the dodecahedron isn't below it, just go straight south (the majority of cases)
-    if (lastValidX < 7 || lastValidX > 24)
+    // Keeps track of where we go from the last place RPS saw us, so there's an idea of where we came out (see odometry.h)
+    odometry.Start(robot.lastValid.x, robot.lastValid.y, robot.lastValid.heading);
+
+    // If nothing on the course map is below it (usually the dodecahedron or the upper level's edge), just go straight south
+    // (the majority of cases). Only the middle of the robot has to be clear - Going off of dead reckoning, the check can't
+    // be any more precise than that anyways.
+    if (courseSegmentIsClear(robot.lastValid.x, robot.lastValid.y, robot.lastValid.x, COURSE_RAMP_BOTTOM, ROBOT_RADIUS / 2))
     {
-        turnNoRPS(lastValidHeading, 270);
+        turnNoRPS(robot.lastValid.heading, 270);
     }
 
     // If it's somewhere generally above the dodecahedron (meaning we should go east for a bit then go straight down)
     else 
     {
         // Turning as close to east as we can get
-        turnNoRPS(lastValidHeading, 0);
+        turnNoRPS(robot.lastValid.heading, 0);
         
-        // Going that way for about a second 
-        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .5);
-        currentLeftMotorPercent = LEFT_MOTOR_PERCENT * .5;
-        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .5);
-        currentRightMotorPercent = RIGHT_MOTOR_PERCENT * .5;
-
-        Sleep(.5);
-
-        // Stopping the motors
-        leftMotor.Stop();
-        currentLeftMotorPercent = 0;
-        rightMotor.Stop();
-        currentRightMotorPercent = 0;
+        // Going that way for a few inches (what used to be half a second)
+        driveDistance(.5, 3.5, .5);
 
         // Turning as close to south as we can get 
         // Makes the assumption that we're currently faced towards zero degrees (we can deal with ~10 degrees of inaccuracy here - Just needs to make it back to RPS)
@@ -466,21 +423,22 @@ void getBackToRPSFromDeadzone()
     }
 
     // Drives until we get RPS back (used for all escape cases)
-    leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .4);
-    currentLeftMotorPercent = LEFT_MOTOR_PERCENT * .4;
-    rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .4);
-    currentRightMotorPercent = RIGHT_MOTOR_PERCENT * .4;
+    drive.SetWheels(.4, .4);
 
-    while (RPS.X() == -1 || RPS.X() == -2) { Sleep(.01); }
+    Deadline deadline(DEADZONE_ESCAPE_TIMEOUT);
+    startTicks(RPS_WAIT_TICK, .01);
+    while ((rpsX() == -1 || rpsX() == -2) && !deadline.HasPassed()) { waitForTick(RPS_WAIT_TICK); }
+    if (deadline.HasPassed())
+        SD.Printf("getBackToRPSFromDeadzone: Still no RPS after %d seconds - Stopping here.\r\n", DEADZONE_ESCAPE_TIMEOUT);
+    else
+        SD.Printf("getBackToRPSFromDeadzone: Back in RPS at (%f, %f), odometry said (%f, %f) heading %f.\r\n", rpsX(), rpsY(),
+                  odometry.X(), odometry.Y(), odometry.Heading());
 
     // Waits another half a second once we get RPS to make sure we're firmly in RPS territory
-    Sleep(.5);
-
-    leftMotor.Stop();
-    currentLeftMotorPercent = 0;
+    schedulerSleep(.5);
 
-    rightMotor.Stop();
-    currentRightMotorPercent = 0;
+    drive.Stop();
+    odometry.Stop();
 }
 
 // Overloaded method that takes in an (x, y) coordinate instead of a heading
@@ -488,16 +446,17 @@ void getBackToRPSFromDeadzone()
 void turn (float endX, float endY) { turn(getDesiredHeading(rpsXToCentroidX(), rpsYToCentroidY(), endX, endY)); }
 void turn (float endHeading)
 {    
-    SD.Printf("turn: Entered function with currentHeading %f and endHeading %f.\r\n", RPS.Heading(), endHeading);
+    SD.Printf("turn: Entered function with currentHeading %f and endHeading %f.\r\n", rpsHeading(), endHeading);
 
     // Don't want to check the tolerance check until RPS is completely valid 
     // Todo - Replace this w/ the more exhaustive check
-    if (loopUntilValidRPS() == -2)
+    int rpsWait = loopUntilValidRPS();
+    if (rpsWait == -2)
     {
         SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
         // Causes the program to skip certain goToPoint calls
-        hasExhaustedDeadzone = true;
+        robot.hasExhaustedDeadzone = true;
 
         // Does what you think it does
         SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -506,49 +465,55 @@ void turn (float endHeading)
         // Escapes this call of goToPoint because it doesn't really have RPS any more
         return;
     }
+    if (rpsWait == -1)
+    {
+        SD.Printf("turn: No RPS, giving up on this one.\r\n");
+        return;
+    }
 
     // Todo - Make it start turning even if it doesn't have RPS based on last remembered values so that we don't have to wait for RPS to be valid to start 
     // Generally, turn() is called as part of goToPoint, which can easily make small autocorrections, hence why this threshold doesn't need to be super small   
-    while (smallestDistanceBetweenHeadings(RPS.Heading(), endHeading) > 8)
+    Deadline deadline(TURN_TIMEOUT);
+    startTicks(TURN_TICK, .01);
+    while (smallestDistanceBetweenHeadings(rpsHeading(), endHeading) > tuning.turnTolerance)
     {
-        clearLCD();
-        LCD.Write("Current Heading: "); LCD.WriteLine(RPS.Heading());
-        LCD.Write("Intended Heading: "); LCD.WriteLine(endHeading);
+        controlIterations++;
+
+        if (deadline.HasPassed())
+        {
+            SD.Printf("turn: Gave up on heading %f after %d seconds.\r\n", endHeading, TURN_TIMEOUT);
+            break;
+        }
+
+        setStatusNumber(STATUS_HEADING, "Heading", rpsHeading());
+        setStatusNumber(STATUS_INTENDED_HEADING, "Intended Heading", endHeading);
 
         // RPS is always valid at this point due to the loopUntilValidRPS call at the end of the loop
         updateLastValidRPSValues();
 
         // Debug 
-        SD.Printf("turn: Given currentHeading = %f and endHeading = %f, going through another iteration of the tolerance loop.\r\n", RPS.Heading(), endHeading);
+        SD.Printf("turn: Given currentHeading = %f and endHeading = %f, going through another iteration of the tolerance loop.\r\n", rpsHeading(), endHeading);
 
         // If turning left is quicker 
-        if (shouldTurnLeft(RPS.Heading(), endHeading))
+        if (shouldTurnLeft(rpsHeading(), endHeading))
         {
-            SD.Printf("turn: Given currentHeading = %f and endHeading = %f, robot is turning left.\r\n", RPS.Heading(), endHeading);
+            SD.Printf("turn: Given currentHeading = %f and endHeading = %f, robot is turning left.\r\n", rpsHeading(), endHeading);
 
             // Todo - If optimizing for time, see how low we can get these thresholds while still being precise enough when it matters 
             // 50+ Degrees Away - Turn as quickly as possible
-            if (smallestDistanceBetweenHeadings(RPS.Heading(), endHeading) > 50)
+            if (smallestDistanceBetweenHeadings(rpsHeading(), endHeading) > tuning.turnFastBand)
             {
                 SD.Printf("turn: Robot is more than 60 degrees away from endHeading. Turning really fast.\r\n");
 
-                leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .4);
-                currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * .4;
-
-                rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .5);
-                currentRightMotorPercent = RIGHT_MOTOR_PERCENT * .5;
+                drive.SetWheels(-.4, .5);
             }
 
             // 25-50 Degrees Away - Turn quick, but not super quick
-            else if (smallestDistanceBetweenHeadings(RPS.Heading(), endHeading) > 25)
+            else if (smallestDistanceBetweenHeadings(rpsHeading(), endHeading) > tuning.turnMediumBand)
             {
                 SD.Printf("turn: Robot is more than 30 degrees away from endHeading. Turning fast, but not super fast.\r\n");
 
-                leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .4);
-                currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * .4;
-
-                rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .4);
-                currentRightMotorPercent = RIGHT_MOTOR_PERCENT * .4;
+                drive.Set(0, .4);
             }
 
             // 0-25 Degrees Away - Turn slowly (precision matters)
@@ -556,29 +521,21 @@ void turn (float endHeading)
             {
                 SD.Printf("turn: Robot is less than 30 degrees away from endHeading. Turning more slowly.\r\n");
 
-                leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .2);
-                currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * .2;
-
-                rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .2);
-                currentRightMotorPercent = RIGHT_MOTOR_PERCENT * .2;
+                drive.Set(0, .2);
             }
         }
 
         // Otherwise, turning right is quicker 
         else
         {
-            SD.Printf("turn: Given currentHeading = %f and endHeading = %f, robot is turning right.\r\n", RPS.Heading(), endHeading);
+            SD.Printf("turn: Given currentHeading = %f and endHeading = %f, robot is turning right.\r\n", rpsHeading(), endHeading);
 
             // 40+ Degrees Away - Turn quick, but not super quick
-            if (smallestDistanceBetweenHeadings(RPS.Heading(), endHeading) > 40)
+            if (smallestDistanceBetweenHeadings(rpsHeading(), endHeading) > tuning.turnRightFastBand)
             {
                 SD.Printf("turn: Robot is more than 30 degrees away from endHeading. Turning faster.\r\n");
 
-                leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .425);
-                currentLeftMotorPercent = LEFT_MOTOR_PERCENT * .425;
-
-                rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .425);
-                currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * .425;
+                drive.Set(0, -.425);
             }
 
             // 0-25 Degrees Away - Turn slowly (precision matters)
@@ -586,27 +543,24 @@ void turn (float endHeading)
             {
                 SD.Printf("turn: Robot is less than 30 degrees away from endHeading. Turning more slowly.\r\n");
 
-                leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .2);
-                currentLeftMotorPercent = LEFT_MOTOR_PERCENT * .2;
-
-                rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .2);
-                currentRightMotorPercent = -RIGHT_MOTOR_PERCENT * .2;
+                drive.Set(0, -.2);
             }
         }
 
         SD.Printf("turn: Finalized motor powers at end of tolerance loop: \r\n");
-        SD.Printf("turn: Left Motor: %f\r\n", currentLeftMotorPercent);
-        SD.Printf("turn: Right Motor: %f\r\n", currentRightMotorPercent);
+        SD.Printf("turn: Left Motor: %f\r\n", robot.leftMotorPercent);
+        SD.Printf("turn: Right Motor: %f\r\n", robot.rightMotorPercent);
 
-        Sleep(.01);
+        waitForTick(TURN_TICK);
 
         // This function itself is naturally blocking; The return value is only relevant if it's in a deadzone 
-        if (loopUntilValidRPS() == -2)
+        rpsWait = loopUntilValidRPS();
+        if (rpsWait == -2)
         {
             SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
             // Causes the program to skip certain goToPoint calls
-            hasExhaustedDeadzone = true;
+            robot.hasExhaustedDeadzone = true;
 
             // Does what you think it does
             SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -615,31 +569,33 @@ void turn (float endHeading)
             // Escapes this call of goToPoint because it doesn't really have RPS any more
             return;
         }
+        if (rpsWait == -1)
+        {
+            SD.Printf("turn: No RPS, giving up on this one.\r\n");
+            return;
+        }
     }
 
-    leftMotor.Stop();
-    currentLeftMotorPercent = 0;
-
-    rightMotor.Stop();
-    currentRightMotorPercent = 0;
+    drive.Stop();
 
     // Crude benchmark debug system
     SD.Printf("///////////////////////////////\r\n");
     SD.Printf("turn: FUNCTION SYNOPSIS: \r\n");
     SD.Printf("turn: Intended Heading: %f\r\n", endHeading);
-    SD.Printf("turn: Actual Heading @ End: %f\r\n", RPS.Heading());
+    SD.Printf("turn: Actual Heading @ End: %f\r\n", rpsHeading());
     SD.Printf("///////////////////////////////\r\n");
 }
 
 void turnToAngleWhenKindaClose(float endHeading)
 {
     // This function itself is naturally blocking; The return value is only relevant if it's in a deadzone
-    if (loopUntilValidRPS() == -2)
+    int rpsWait = loopUntilValidRPS();
+    if (rpsWait == -2)
     {
         SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
         // Causes the program to skip certain goToPoint calls
-        hasExhaustedDeadzone = true;
+        robot.hasExhaustedDeadzone = true;
 
         // Does what you think it does
         SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -648,35 +604,48 @@ void turnToAngleWhenKindaClose(float endHeading)
         // Escapes this call of goToPoint because it doesn't really have RPS any more
         return;
     }
+    if (rpsWait == -1)
+    {
+        SD.Printf("turnToAngleWhenKindaClose: No RPS, giving up on this one.\r\n");
+        return;
+    }
 
-    while (smallestDistanceBetweenHeadings(RPS.Heading(), endHeading) > 5)
+    Deadline deadline(PRECISE_TURN_TIMEOUT);
+    while (smallestDistanceBetweenHeadings(rpsHeading(), endHeading) > tuning.kindaCloseTolerance)
     {
-        if (shouldTurnLeft(RPS.Heading(), endHeading))
+        controlIterations++;
+
+        if (deadline.HasPassed())
+        {
+            SD.Printf("turnToAngleWhenKindaClose: Gave up on heading %f after %d seconds.\r\n", endHeading, PRECISE_TURN_TIMEOUT);
+            break;
+        }
+
+        if (shouldTurnLeft(rpsHeading(), endHeading))
         {
-            leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .2);
-            rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .2);
+            drive.Pulse(-.2, .2);
         }
 
         else
         {
-            leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .2);
-            rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .2);
+            drive.Pulse(.2, -.2);
         }
 
         // .125 results in too much overshooting, .05 never overshoots. This is hopefully a happy medium that usually gets it first try but may need one or two extra passes.
-        Sleep(.15);
-        leftMotor.Stop();
-        rightMotor.Stop();
+        Sleep(tuning.kindaClosePulse);
+        drive.Stop();
 
-        Sleep(.34);
+        // The pulse itself stays a plain Sleep() so nothing stretches it, but background tasks can run while it settles
+        schedulerSleep(tuning.pulseSettleTime);
 
         // This function itself is naturally blocking; The return value is only relevant if it's in a deadzone
-        if (loopUntilValidRPS() == -2)
+        rpsWait = loopUntilValidRPS();
+        if (rpsWait == -2)
         {
             SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
             // Causes the program to skip certain goToPoint calls
-            hasExhaustedDeadzone = true;
+            robot.hasExhaustedDeadzone = true;
 
             // Does what you think it does
             SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -685,24 +654,30 @@ void turnToAngleWhenKindaClose(float endHeading)
             // Escapes this call of goToPoint because it doesn't really have RPS any more
             return;
         }
+        if (rpsWait == -1)
+        {
+            SD.Printf("turnToAngleWhenKindaClose: No RPS, giving up on this one.\r\n");
+            return;
+        }
     }
 
     SD.Printf("///////////////////////////////\r\n");
     SD.Printf("accurateTurn: FUNCTION SYNOPSIS: \r\n");
     SD.Printf("accurateTurn: Intended Heading: %f\r\n", endHeading);
-    SD.Printf("accurateTurn: Actual Heading @ End: %f\r\n", RPS.Heading());
+    SD.Printf("accurateTurn: Actual Heading @ End: %f\r\n", rpsHeading());
     SD.Printf("///////////////////////////////\r\n");
 }
 
 void turnToAngleWhenAlreadyReallyClose(float endHeading)
 {
     // This function itself is naturally blocking; The return value is only relevant if it's in a deadzone
-    if (loopUntilValidRPS() == -2)
+    int rpsWait = loopUntilValidRPS();
+    if (rpsWait == -2)
     {
         SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
         // Causes the program to skip certain goToPoint calls
-        hasExhaustedDeadzone = true;
+        robot.hasExhaustedDeadzone = true;
 
         // Does what you think it does
         SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -711,35 +686,48 @@ void turnToAngleWhenAlreadyReallyClose(float endHeading)
         // Escapes this call of goToPoint because it doesn't really have RPS any more
         return;
     }
+    if (rpsWait == -1)
+    {
+        SD.Printf("turnToAngleWhenAlreadyReallyClose: No RPS, giving up on this one.\r\n");
+        return;
+    }
 
-    while (smallestDistanceBetweenHeadings(RPS.Heading(), endHeading) > 1.5)
+    Deadline deadline(PRECISE_TURN_TIMEOUT);
+    while (smallestDistanceBetweenHeadings(rpsHeading(), endHeading) > tuning.reallyCloseTolerance)
     {
-        if (shouldTurnLeft(RPS.Heading(), endHeading))
+        controlIterations++;
+
+        if (deadline.HasPassed())
         {
-            leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .2);
-            rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .2);
+            SD.Printf("turnToAngleWhenAlreadyReallyClose: Gave up on heading %f after %d seconds.\r\n", endHeading, PRECISE_TURN_TIMEOUT);
+            break;
+        }
+
+        if (shouldTurnLeft(rpsHeading(), endHeading))
+        {
+            drive.Pulse(-.2, .2);
         }
 
         else
         {
-            leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .2);
-            rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .2);
+            drive.Pulse(.2, -.2);
         }
 
         // .125 results in too much overshooting, .05 never overshoots. This is hopefully a happy medium that usually gets it first try but may need one or two extra passes.
-        Sleep(.075);
-        leftMotor.Stop();
-        rightMotor.Stop();
+        Sleep(tuning.reallyClosePulse);
+        drive.Stop();
 
-        Sleep(.34);
+        // The pulse itself stays a plain Sleep() so nothing stretches it, but background tasks can run while it settles
+        schedulerSleep(tuning.pulseSettleTime);
 
         // This function itself is naturally blocking; The return value is only relevant if it's in a deadzone
-        if (loopUntilValidRPS() == -2)
+        rpsWait = loopUntilValidRPS();
+        if (rpsWait == -2)
         {
             SD.Printf("goToPoint: Deadzone has become enabled again.\r\n");
 
             // Causes the program to skip certain goToPoint calls
-            hasExhaustedDeadzone = true;
+            robot.hasExhaustedDeadzone = true;
 
             // Does what you think it does
             SD.Printf("goToPoint: Turning roughly south and going until RPS.\r\n");
@@ -748,12 +736,17 @@ void turnToAngleWhenAlreadyReallyClose(float endHeading)
             // Escapes this call of goToPoint because it doesn't really have RPS any more
             return;
         }
+        if (rpsWait == -1)
+        {
+            SD.Printf("turnToAngleWhenAlreadyReallyClose: No RPS, giving up on this one.\r\n");
+            return;
+        }
     }
 
     SD.Printf("///////////////////////////////\r\n");
     SD.Printf("accurateTurn: FUNCTION SYNOPSIS: \r\n");
     SD.Printf("accurateTurn: Intended Heading: %f\r\n", endHeading);
-    SD.Printf("accurateTurn: Actual Heading @ End: %f\r\n", RPS.Heading());
+    SD.Printf("accurateTurn: Actual Heading @ End: %f\r\n", rpsHeading());
     SD.Printf("///////////////////////////////\r\n");
 }
 
@@ -762,29 +755,11 @@ void turnToAngleWhenAlreadyReallyClose(float endHeading)
 void turnNoRPS(float currentHeading, float endHeading)
 {
     // Todo - See if I can up the motor speeds here a little bit to save time (only worth doing if we're at 100 points consistently) 
-    // To up the motor speeds, I'd have to figure out Seconds_Per_Degree for every motor speed I want to use and implement them all...
-    // That isn't really bad, but also isn't something I want to implement before we have more of the course consistently done 
-
-    if (shouldTurnLeft(currentHeading, endHeading))
-    {
-        leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .4);
-        currentLeftMotorPercent = -LEFT_MOTOR_PERCENT * .4;
-
-        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .4);
-        currentRightMotorPercent = RIGHT_MOTOR_PERCENT * .4;
-    }
-
-    else 
-    {
-        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .4);
-        currentLeftMotorPercent = LEFT_MOTOR_PERCENT * .4;
-
-        rightMotor.SetPercent(-LEFT_MOTOR_PERCENT * .4);
-        currentRightMotorPercent = RIGHT_MOTOR_PERCENT * .4;
-    }
+    // Going by the encoders, the speed can change without re-measuring anything
 
-    // Degrees * (Seconds / Degrees) = Seconds
-    Sleep(smallestDistanceBetweenHeadings(currentHeading, endHeading) * SECONDS_PER_DEGREE);
+    // Turns by the encoders - Degrees * (Seconds / Degrees) = Seconds is only what it falls back on if they aren't counting
+    float degrees = smallestDistanceBetweenHeadings(currentHeading, endHeading);
+    turnDegrees(shouldTurnLeft(currentHeading, endHeading) ? .4 : -.4, degrees, degrees * SECONDS_PER_DEGREE);
 }
 
 #endif
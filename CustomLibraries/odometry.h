@@ -0,0 +1,182 @@
+#ifndef ODOMETRY_H
+#define ODOMETRY_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "constants.h"
+#include "conversions.h"
+#include "deadline.h"
+#include "drive.h"
+#include "scheduler.h"
+
+/*
+ * Wheel encoder odometry - How far the robot has gone and turned when RPS can't say (the deadzone, or moves too quick for
+ * RPS to keep up with). The encoders count on interrupts no matter what, so nothing gets missed; stepOdometry() just reads
+ * the counts every ODOMETRY_PERIOD while odometry is running and adds up the difference into (x, y, heading).
+ *
+ * Our encoders are single-channel, so a count doesn't say which way the wheel went. Odometry goes off of which way Drive
+ * last told that wheel to go (a wheel that's been told to stop is still coasting the way it was going).
+ *
+ * Only runs between Start() and Stop(), since every read goes in the recording - Anything that drives by distance
+ * (driveDistance(), turnDegrees()) starts it for itself if it isn't already running.
+ */
+
+#define ENCODER_COUNTS_PER_INCH 40.5    // Of tread travel - Measured by pushing the robot along a yardstick
+#define ODOMETRY_PERIOD .02             // Seconds between reads
+
+class Odometry
+{
+public:
+    Odometry() : x(0), y(0), heading(0), distance(0), turned(0), leftCounts(0), rightCounts(0), leftSign(1), rightSign(1),
+                 isRunning(false) {}
+
+    /**
+     * @brief Start starts tracking from the given pose (RPS coordinates - inches and degrees).
+     */
+    void Start(float startX, float startY, float startHeading)
+    {
+        x = startX;
+        y = startY;
+        heading = startHeading;
+        leftCounts = robot.hardware.leftEncoder.Counts();
+        rightCounts = robot.hardware.rightEncoder.Counts();
+        isRunning = true;
+
+        PeriodicTask &task = periodicTasks[ODOMETRY_TASK];
+        task.isEnabled = true;
+        task.nextRelease = timeNow() + task.period;
+    }
+
+    void Stop()
+    {
+        Update();
+        isRunning = false;
+        periodicTasks[ODOMETRY_TASK].isEnabled = false;
+    }
+
+    /**
+     * @brief Update adds in however far the wheels have gone since the last update.
+     */
+    void Update()
+    {
+        if (!isRunning)
+            return;
+
+        // Which way each wheel is going - Only changes when the wheel's told to go somewhere
+        if (drive.Left() != 0)
+            leftSign = drive.Left() > 0 ? 1 : -1;
+        if (drive.Right() != 0)
+            rightSign = drive.Right() > 0 ? 1 : -1;
+
+        int newLeftCounts = robot.hardware.leftEncoder.Counts(), newRightCounts = robot.hardware.rightEncoder.Counts();
+        float left = leftSign * (newLeftCounts - leftCounts) / ENCODER_COUNTS_PER_INCH;
+        float right = rightSign * (newRightCounts - rightCounts) / ENCODER_COUNTS_PER_INCH;
+        leftCounts = newLeftCounts;
+        rightCounts = newRightCounts;
+
+        // Straight ahead along the heading halfway through the step
+        float forward = (left + right) / 2;
+        float turn = radianToDegree((right - left) / TRACK_WIDTH);
+        float middleHeading = degreeToRadian(heading + turn / 2);
+        x += forward * cos(middleHeading);
+        y += forward * sin(middleHeading);
+        heading = fmod(heading + turn + 360, 360);
+
+        distance += forward;
+        turned += turn;
+    }
+
+    bool IsRunning() const { return isRunning; }
+
+    // Where odometry thinks the robot is
+    float X() const { return x; }
+    float Y() const { return y; }
+    float Heading() const { return heading; }
+
+    // Running totals since boot - Inches forwards (backwards takes away) and degrees left (right takes away)
+    float Distance() const { return distance; }
+    float Turned() const { return turned; }
+
+private:
+    float x, y, heading;
+    float distance, turned;
+    int leftCounts, rightCounts;
+    int leftSign, rightSign;
+    bool isRunning;
+};
+
+ROBOT_STATE Odometry odometry;
+
+/**
+ * @brief stepOdometry is odometry's background task.
+ */
+void stepOdometry() { odometry.Update(); }
+
+// What an odometry move goes until
+enum { ODOMETRY_DISTANCE, ODOMETRY_TURN };
+
+/**
+ * @brief moveByOdometry drives at the given speeds until odometry has gone "amount" inches (or turned "amount" degrees),
+ * then stops. If the encoders aren't counting it goes for expectedSeconds instead (what the move used to be timed at), and
+ * it never goes for more than twice that.
+ * @return Whether it went by the encoders.
+ */
+bool moveByOdometry(int measure, float linear, float angular, float amount, float expectedSeconds)
+{
+    bool wasRunning = odometry.IsRunning();
+    if (!wasRunning)
+        odometry.Start(robot.lastValid.x, robot.lastValid.y, robot.lastValid.heading);
+
+    float start = measure == ODOMETRY_DISTANCE ? odometry.Distance() : odometry.Turned();
+    float gone = 0;
+    bool isCounting = false;
+    Deadline deadline(2 * expectedSeconds);
+
+    drive.Set(linear, angular);
+    startTicks(ODOMETRY_TICK, ODOMETRY_PERIOD);
+    while (!deadline.HasPassed())
+    {
+        gone = fabs((measure == ODOMETRY_DISTANCE ? odometry.Distance() : odometry.Turned()) - start);
+        isCounting = isCounting || gone > 0;
+
+        if (gone >= amount)
+            break;
+        if (!isCounting && deadline.SecondsElapsed() >= expectedSeconds)
+            break;
+
+        waitForTick(ODOMETRY_TICK);
+    }
+    drive.Stop();
+
+    if (!isCounting)
+        SD.Printf("Odometry: No encoder counts - Went by time (%f s) instead.\r\n", expectedSeconds);
+    else if (gone < amount)
+        SD.Printf("Odometry: Only got %f of %f before giving up.\r\n", gone, amount);
+
+    if (!wasRunning)
+        odometry.Stop();
+    return isCounting;
+}
+
+/**
+ * @brief driveDistance drives straight at the given speed (negative for backwards) for the given inches.
+ */
+bool driveDistance(float speed, float inches, float expectedSeconds)
+{
+    return moveByOdometry(ODOMETRY_DISTANCE, speed, 0, inches, expectedSeconds);
+}
+
+/**
+ * @brief turnDegrees turns in place at the given speed (positive for left) for the given degrees.
+ */
+bool turnDegrees(float speed, float degrees, float expectedSeconds)
+{
+    return moveByOdometry(ODOMETRY_TURN, 0, speed, degrees, expectedSeconds);
+}
+
+#endif // ODOMETRY_H
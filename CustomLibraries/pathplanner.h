@@ -0,0 +1,321 @@
+#ifndef PATHPLANNER_H
+#define PATHPLANNER_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// Custom Libraries
+#include "course.h"
+#include "navigation.h"
+
+/*
+ * Path planner. Finds the shortest way between two points that keeps the robot clear of everything on the course map
+ * (course.h), so a goToPoint target can be given straight out instead of through hand-picked detour points.
+ *
+ *  - The course gets split into PATH_CELL_SIZE squares, and any square where the robot would be touching something is
+ *    blocked. That grid only gets worked out once, the first time anything gets planned.
+ *  - A* finds the shortest path through the open squares (8 directions, squares on the ramp cost a bit more since it's
+ *    slower going).
+ *  - The path gets pulled tight - Any point the robot can skip past in a straight line gets dropped - so what's left is
+ *    just the corners, and goToPoint drives straight between them.
+ *
+ * If the straight line is already clear, none of that happens and the path is just the end point.
+ *
+ * Start and end points are allowed to be somewhere the robot's touching something (like the DDR buttons, which we drive
+ * into on purpose). The path just goes to the nearest open square first/from the nearest open square last.
+ *
+ * Paths get cached by which squares they start and end in, so a path that's driven more than once only gets planned once.
+ */
+
+#define PATH_CELL_SIZE 1                        // Inches
+#define PATH_CLEARANCE (ROBOT_RADIUS + .25)     // How far the robot's centroid has to stay from everything
+#define PATH_RAMP_COST 1.5                      // How much more a square on the ramp costs to go through than a flat one
+#define PATH_MAX_WAYPOINTS 8
+#define PATH_CACHE_SIZE 16
+#define PATH_HEAP_SIZE 4096                     // Squares can be in the open list more than once, so it's bigger than the grid
+
+const int PATH_GRID_WIDTH = (int) (COURSE_WIDTH / PATH_CELL_SIZE);
+const int PATH_GRID_HEIGHT = (int) (COURSE_HEIGHT / PATH_CELL_SIZE);
+const int PATH_CELL_COUNT = PATH_GRID_WIDTH * PATH_GRID_HEIGHT;
+
+/**
+ * @brief PlannedPath is the corners a path goes through, ending with the end point itself.
+ */
+struct PlannedPath
+{
+    int startCell, endCell;
+    int waypointCount;
+    float waypoints[PATH_MAX_WAYPOINTS][2];
+};
+
+ROBOT_STATE bool isPathGridBuilt = false;
+ROBOT_STATE bool isCellBlocked[PATH_CELL_COUNT];
+
+ROBOT_STATE PlannedPath pathCache[PATH_CACHE_SIZE];
+ROBOT_STATE int pathCacheCount = 0, nextPathCacheSlot = 0;
+
+// Grid <-> course coordinates (cells are numbered row by row from the bottom left)
+int cellAt(float x, float y)
+{
+    int column = (int) (x / PATH_CELL_SIZE), row = (int) (y / PATH_CELL_SIZE);
+    column = column < 0 ? 0 : (column >= PATH_GRID_WIDTH ? PATH_GRID_WIDTH - 1 : column);
+    row = row < 0 ? 0 : (row >= PATH_GRID_HEIGHT ? PATH_GRID_HEIGHT - 1 : row);
+    return row * PATH_GRID_WIDTH + column;
+}
+float cellX(int cell) { return (cell % PATH_GRID_WIDTH + .5) * PATH_CELL_SIZE; }
+float cellY(int cell) { return (cell / PATH_GRID_WIDTH + .5) * PATH_CELL_SIZE; }
+
+bool isOnRamp(float x, float y) { return x > COURSE_RAMP_LEFT && x < COURSE_RAMP_RIGHT && y > COURSE_RAMP_BOTTOM && y < COURSE_RAMP_TOP; }
+
+// Works out which squares are blocked - Only has to happen once, the map doesn't change
+void buildPathGrid()
+{
+    for (int cell = 0; cell < PATH_CELL_COUNT; cell++)
+        isCellBlocked[cell] = courseObstacleAt(cellX(cell), cellY(cell), PATH_CLEARANCE) != -1;
+    isPathGridBuilt = true;
+}
+
+// Closest open square to a point (the point's own square if it's open)
+int nearestOpenCell(float x, float y)
+{
+    int closest = -1;
+    float closestDistance = 0;
+    for (int cell = 0; cell < PATH_CELL_COUNT; cell++)
+    {
+        if (isCellBlocked[cell])
+            continue;
+        float distance = getDistance(x, y, cellX(cell), cellY(cell));
+        if (closest == -1 || distance < closestDistance)
+        {
+            closest = cell;
+            closestDistance = distance;
+        }
+    }
+    return closest;
+}
+
+/*
+ * A* bookkeeping. The open list is a binary heap of cells ordered by estimated total cost. Static so it stays off the stack.
+ */
+ROBOT_STATE float pathCost[PATH_CELL_COUNT], pathEstimate[PATH_CELL_COUNT];
+ROBOT_STATE short pathParent[PATH_CELL_COUNT];
+ROBOT_STATE bool isCellClosed[PATH_CELL_COUNT];
+ROBOT_STATE short pathHeap[PATH_HEAP_SIZE];
+ROBOT_STATE int pathHeapSize;
+
+void swapHeapEntries(int a, int b) { short cell = pathHeap[a]; pathHeap[a] = pathHeap[b]; pathHeap[b] = cell; }
+
+void pushPathHeap(int cell)
+{
+    if (pathHeapSize == PATH_HEAP_SIZE)
+        return;
+
+    int i = pathHeapSize++;
+    pathHeap[i] = cell;
+    while (i > 0 && pathEstimate[pathHeap[(i - 1) / 2]] > pathEstimate[pathHeap[i]])
+    {
+        swapHeapEntries(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+int popPathHeap()
+{
+    int top = pathHeap[0];
+    pathHeap[0] = pathHeap[--pathHeapSize];
+    int i = 0;
+    while (true)
+    {
+        int smallest = i, left = 2 * i + 1, right = 2 * i + 2;
+        if (left < pathHeapSize && pathEstimate[pathHeap[left]] < pathEstimate[pathHeap[smallest]])
+            smallest = left;
+        if (right < pathHeapSize && pathEstimate[pathHeap[right]] < pathEstimate[pathHeap[smallest]])
+            smallest = right;
+        if (smallest == i)
+            return top;
+        swapHeapEntries(i, smallest);
+        i = smallest;
+    }
+}
+
+/**
+ * @brief findGridPath runs A* between two open squares.
+ * @return Whether there was a path - If there was, pathParent leads back from endCell to startCell.
+ */
+bool findGridPath(int startCell, int endCell)
+{
+    for (int cell = 0; cell < PATH_CELL_COUNT; cell++)
+    {
+        pathCost[cell] = -1;
+        isCellClosed[cell] = false;
+    }
+
+    float endX = cellX(endCell), endY = cellY(endCell);
+    pathCost[startCell] = 0;
+    pathEstimate[startCell] = getDistance(cellX(startCell), cellY(startCell), endX, endY);
+    pathParent[startCell] = -1;
+    pathHeapSize = 0;
+    pushPathHeap(startCell);
+
+    while (pathHeapSize > 0)
+    {
+        int cell = popPathHeap();
+        if (cell == endCell)
+            return true;
+        if (isCellClosed[cell])
+            continue;
+        isCellClosed[cell] = true;
+
+        int column = cell % PATH_GRID_WIDTH, row = cell / PATH_GRID_WIDTH;
+        for (int dx = -1; dx <= 1; dx++)
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                int nextColumn = column + dx, nextRow = row + dy;
+                if ((dx == 0 && dy == 0) || nextColumn < 0 || nextColumn >= PATH_GRID_WIDTH || nextRow < 0 || nextRow >= PATH_GRID_HEIGHT)
+                    continue;
+
+                int next = nextRow * PATH_GRID_WIDTH + nextColumn;
+                if (isCellBlocked[next] || isCellClosed[next])
+                    continue;
+
+                float step = (dx != 0 && dy != 0 ? 1.41421356 : 1) * PATH_CELL_SIZE;
+                if (isOnRamp(cellX(next), cellY(next)))
+                    step *= PATH_RAMP_COST;
+
+                float cost = pathCost[cell] + step;
+                if (pathCost[next] < 0 || cost < pathCost[next])
+                {
+                    pathCost[next] = cost;
+                    pathEstimate[next] = cost + getDistance(cellX(next), cellY(next), endX, endY);
+                    pathParent[next] = cell;
+                    pushPathHeap(next);
+                }
+            }
+    }
+
+    return false;
+}
+
+/**
+ * @brief planPath fills in the corners of the shortest clear path from (startX, startY) to (endX, endY).
+ * @return Whether there's a path at all - A path that needs more than PATH_MAX_WAYPOINTS points doesn't count, since its
+ * last leg wouldn't be clear.
+ */
+bool planPath(float startX, float startY, float endX, float endY, PlannedPath &path)
+{
+    path.startCell = cellAt(startX, startY);
+    path.endCell = cellAt(endX, endY);
+    path.waypointCount = 0;
+
+    // Nothing in the way - Straight there
+    if (courseSegmentIsClear(startX, startY, endX, endY, PATH_CLEARANCE))
+    {
+        path.waypoints[0][0] = endX;
+        path.waypoints[0][1] = endY;
+        path.waypointCount = 1;
+        return true;
+    }
+
+    if (!isPathGridBuilt)
+        buildPathGrid();
+
+    int startCell = nearestOpenCell(startX, startY), endCell = nearestOpenCell(endX, endY);
+    if (startCell == -1 || endCell == -1 || !findGridPath(startCell, endCell))
+        return false;
+
+    // Walks back from the end to get the squares in order (reusing the heap's space, it's done with)
+    int cellCount = 0;
+    for (int cell = endCell; cell != -1; cell = pathParent[cell])
+        pathHeap[cellCount++] = cell;
+
+    // Pulls the path tight - From each corner, goes to the furthest square along the path that's in a straight line from it
+    float cornerX = startX, cornerY = startY;
+    int i = cellCount - 1;
+    bool hasReachedEnd = false;
+    while (i >= 0 && path.waypointCount < PATH_MAX_WAYPOINTS - 1)
+    {
+        // Skips ahead to the end if it's in sight (that's the only way out of here when the end is somewhere blocked)
+        if (courseSegmentIsClear(cornerX, cornerY, endX, endY, PATH_CLEARANCE))
+        {
+            hasReachedEnd = true;
+            break;
+        }
+
+        int furthest = i;
+        for (int j = i; j >= 0; j--)
+            if (courseSegmentIsClear(cornerX, cornerY, cellX(pathHeap[j]), cellY(pathHeap[j]), PATH_CLEARANCE))
+                furthest = j;
+        if (furthest == 0)
+        {
+            hasReachedEnd = true;
+            break;
+        }
+
+        cornerX = cellX(pathHeap[furthest]);
+        cornerY = cellY(pathHeap[furthest]);
+        path.waypoints[path.waypointCount][0] = cornerX;
+        path.waypoints[path.waypointCount][1] = cornerY;
+        path.waypointCount++;
+        i = furthest - 1;
+    }
+
+    // Ran out of room for corners with the end still out of sight - Better no path than one through something
+    if (!hasReachedEnd)
+    {
+        SD.Printf("Path planner: (%f, %f) to (%f, %f) needs more than %d points.\r\n", startX, startY, endX, endY, PATH_MAX_WAYPOINTS);
+        return false;
+    }
+
+    path.waypoints[path.waypointCount][0] = endX;
+    path.waypoints[path.waypointCount][1] = endY;
+    path.waypointCount++;
+    return true;
+}
+
+/**
+ * @brief findPath is planPath, but checks the cache first (and saves whatever it plans to it).
+ * @return The path, or 0 if there isn't one.
+ */
+const PlannedPath *findPath(float startX, float startY, float endX, float endY)
+{
+    int startCell = cellAt(startX, startY), endCell = cellAt(endX, endY);
+    for (int i = 0; i < pathCacheCount; i++)
+        if (pathCache[i].startCell == startCell && pathCache[i].endCell == endCell)
+            return &pathCache[i];
+
+    PlannedPath path;
+    if (!planPath(startX, startY, endX, endY, path))
+    {
+        SD.Printf("Path planner: No way from (%f, %f) to (%f, %f).\r\n", startX, startY, endX, endY);
+        return 0;
+    }
+
+    // Takes the place of the oldest one once the cache is full
+    PlannedPath &cached = pathCache[nextPathCacheSlot];
+    cached = path;
+
+    SD.Printf("Path planner: (%f, %f) to (%f, %f) goes through %d point(s).\r\n", startX, startY, endX, endY, path.waypointCount);
+    nextPathCacheSlot = (nextPathCacheSlot + 1) % PATH_CACHE_SIZE;
+    if (pathCacheCount < PATH_CACHE_SIZE)
+        pathCacheCount++;
+    return &cached;
+}
+
+/**
+ * @brief goToPointPlanned is goToPoint for points that might not be in a straight line from here. It drives through the
+ * corners of the planned path, then does a normal goToPoint to the end point. Without a path, it's just the goToPoint.
+ * Parameters are the same as goToPoint's.
+ */
+void goToPointPlanned(float endX, float endY, bool shouldTurnToEndHeading, float endHeading, int mode)
+{
+    updateLastValidRPSValues();
+    const PlannedPath *path = findPath(robot.lastValid.x, robot.lastValid.y, endX, endY);
+
+    // All but the last point are just corners to get around
+    for (int i = 0; path && i < path->waypointCount - 1 && !robot.hasExhaustedDeadzone; i++)
+        goToPoint(path->waypoints[i][0], path->waypoints[i][1], false, 0.0, false, 0.0, false, mode);
+
+    goToPoint(endX, endY, shouldTurnToEndHeading, endHeading, false, 0.0, false, mode);
+}
+
+#endif // PATHPLANNER_H
@@ -0,0 +1,470 @@
+#ifndef POSEPATH_H
+#define POSEPATH_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "course.h"
+#include "deadline.h"
+#include "navigation.h"
+#include "pathplanner.h"
+
+/*
+ * Pose paths. goToPoint with shouldTurnToEndHeading turns in place, drives straight, then turns in place again, and then
+ * the segments usually do a precise turn on top of that. goToPose() instead drives one smooth path that ends at the point
+ * already facing the right way.
+ *
+ * The path is a Dubins path - The shortest way from one pose to another for something that can only go forwards and can't
+ * turn tighter than POSE_TURN_RADIUS. It's always some combination of three pieces, each either a left arc, a right arc,
+ * or a straight line (LSL, RSR, LSR, RSL, RLR, LRL), so it gets worked out in closed form instead of searched for.
+ *
+ * Reversing: a path driven backwards is just the forwards path for the robot turned around, so when backing up is allowed
+ * both get worked out and the shorter one wins. The whole path goes one way or the other - There's no stopping partway to
+ * switch directions (that's what full Reeds-Shepp paths would add, and we've never needed it).
+ *
+ * The follower is pure pursuit - Every pass it finds where along the path the robot is, picks the point POSE_LOOKAHEAD
+ * further on, and sets the wheels to drive the arc that goes through it. It runs on the goToPoint tick.
+ *
+ * Every candidate path gets checked against the course map (course.h) with the path planner's clearance, and only clear
+ * ones count. The stations are right up against the things they're on, though, so within POSE_NEAR_DISTANCE of the start
+ * or the end the path only has to stay as far from things as that end already is.
+ *
+ * If no path is clear, or the shortest clear one would take longer than turning in place, driving straight there and
+ * turning in place again (the point's close by and off to the side, so the path has to loop around), goToPose() falls back
+ * on turn-drive-turn - goToPoint going whichever way means less turning, or goToPointPlanned if the straight line isn't
+ * clear either.
+ */
+
+#define POSE_TURN_RADIUS 3.5            // Inches - Tightest arc a path is allowed to use (inside wheel stopped)
+#define POSE_LOOKAHEAD 3                // Inches ahead on the path that the follower steers towards
+#define POSE_FINAL_STRAIGHT 2           // Inches every path ends with going straight, so the heading's settled by the end
+#define POSE_END_TOLERANCE .5           // Inches from the end that counts as there
+#define POSE_SLOW_DOWN_DISTANCE 4       // Inches from the end where it starts slowing down
+#define POSE_TIMEOUT 15                 // Seconds before the follower gives up
+#define POSE_INCHES_PER_DEGREE .06      // Inches the robot could drive in the time it takes to turn a degree in place
+#define POSE_TURN_OVERHEAD_INCHES 3     // Inches it could drive in the time every turn in place takes to stop and settle
+#define POSE_CHECK_STEP .5              // Inches between the points of a path that get checked against the course
+#define POSE_NEAR_DISTANCE 6            // Inches from the start or the end where the path can get as close to things as they are
+
+// What each of a path's three pieces is
+enum { POSE_LEFT, POSE_STRAIGHT, POSE_RIGHT };
+
+/**
+ * @brief PosePath is a Dubins path - Three pieces, each an arc or a straight line, from a start pose.
+ * Lengths are in inches. Headings in here are radians (the same direction as RPS headings - Counterclockwise from east).
+ */
+struct PosePath
+{
+    float startX, startY, startHeading;
+    float radius;
+    int types[3];
+    float lengths[3];
+    float length;
+    bool isReversed;        // Driven backwards - startHeading (and every heading along it) is the way the back of the robot faces
+};
+
+/**
+ * @brief PoseClearance is what a path gets checked against the course with - How close its ends already are to things.
+ */
+struct PoseClearance
+{
+    float startX, startY, startClearance;
+    float endX, endY, endClearance;
+};
+
+float wrapRadians(float angle)
+{
+    angle = fmod(angle, 2 * PI);
+    return angle < 0 ? angle + 2 * PI : angle;
+}
+
+/**
+ * @brief findDubinsWord works out one of the six kinds of path, with everything scaled so the turn radius is 1.
+ * @return Whether that kind of path can get there at all.
+ */
+bool findDubinsWord(int word, float d, float alpha, float beta, float pieces[3])
+{
+    float sa = sin(alpha), sb = sin(beta), ca = cos(alpha), cb = cos(beta), cab = cos(alpha - beta);
+    float squared, angle;
+
+    switch (word)
+    {
+    case 0: // LSL
+        squared = 2 + d * d - 2 * cab + 2 * d * (sa - sb);
+        if (squared < 0)
+            return false;
+        angle = atan2(cb - ca, d + sa - sb);
+        pieces[0] = wrapRadians(angle - alpha);
+        pieces[1] = sqrt(squared);
+        pieces[2] = wrapRadians(beta - angle);
+        return true;
+
+    case 1: // RSR
+        squared = 2 + d * d - 2 * cab + 2 * d * (sb - sa);
+        if (squared < 0)
+            return false;
+        angle = atan2(ca - cb, d - sa + sb);
+        pieces[0] = wrapRadians(alpha - angle);
+        pieces[1] = sqrt(squared);
+        pieces[2] = wrapRadians(angle - beta);
+        return true;
+
+    case 2: // LSR
+        squared = -2 + d * d + 2 * cab + 2 * d * (sa + sb);
+        if (squared < 0)
+            return false;
+        pieces[1] = sqrt(squared);
+        angle = atan2(-ca - cb, d + sa + sb) - atan2(-2.0, pieces[1]);
+        pieces[0] = wrapRadians(angle - alpha);
+        pieces[2] = wrapRadians(angle - beta);
+        return true;
+
+    case 3: // RSL
+        squared = -2 + d * d + 2 * cab - 2 * d * (sa + sb);
+        if (squared < 0)
+            return false;
+        pieces[1] = sqrt(squared);
+        angle = atan2(ca + cb, d - sa - sb) - atan2(2.0, pieces[1]);
+        pieces[0] = wrapRadians(alpha - angle);
+        pieces[2] = wrapRadians(beta - angle);
+        return true;
+
+    case 4: // RLR
+        squared = (6 - d * d + 2 * cab + 2 * d * (sa - sb)) / 8;
+        if (fabs(squared) > 1)
+            return false;
+        angle = atan2(ca - cb, d - sa + sb);
+        pieces[1] = wrapRadians(2 * PI - acos(squared));
+        pieces[0] = wrapRadians(alpha - angle + pieces[1] / 2);
+        pieces[2] = wrapRadians(alpha - beta - pieces[0] + pieces[1]);
+        return true;
+
+    default: // LRL
+        squared = (6 - d * d + 2 * cab + 2 * d * (sb - sa)) / 8;
+        if (fabs(squared) > 1)
+            return false;
+        angle = atan2(ca - cb, d + sa - sb);
+        pieces[1] = wrapRadians(2 * PI - acos(squared));
+        pieces[0] = wrapRadians(-alpha - angle + pieces[1] / 2);
+        pieces[2] = wrapRadians(beta - alpha - pieces[0] + pieces[1]);
+        return true;
+    }
+}
+
+// Which piece types go with each of the words above
+const int DUBINS_WORDS[6][3] =
+{
+    { POSE_LEFT, POSE_STRAIGHT, POSE_LEFT },
+    { POSE_RIGHT, POSE_STRAIGHT, POSE_RIGHT },
+    { POSE_LEFT, POSE_STRAIGHT, POSE_RIGHT },
+    { POSE_RIGHT, POSE_STRAIGHT, POSE_LEFT },
+    { POSE_RIGHT, POSE_LEFT, POSE_RIGHT },
+    { POSE_LEFT, POSE_RIGHT, POSE_LEFT }
+};
+
+/**
+ * @brief posePathPoint finds where along a path the robot should be after "distance" inches. Past the end, it keeps going
+ * straight, so the follower always has something to steer towards.
+ * @param heading comes back in radians, and for reversed paths it's the way the back of the robot faces.
+ */
+void posePathPoint(const PosePath &path, float distance, float &x, float &y, float &heading)
+{
+    x = path.startX;
+    y = path.startY;
+    heading = path.startHeading;
+
+    for (int i = 0; i < 3 && distance > 0; i++)
+    {
+        float length = distance < path.lengths[i] ? distance : path.lengths[i];
+        float turned = length / path.radius;
+        if (path.types[i] == POSE_LEFT)
+        {
+            x += path.radius * (sin(heading + turned) - sin(heading));
+            y += path.radius * (cos(heading) - cos(heading + turned));
+            heading += turned;
+        }
+        else if (path.types[i] == POSE_RIGHT)
+        {
+            x += path.radius * (sin(heading) - sin(heading - turned));
+            y += path.radius * (cos(heading - turned) - cos(heading));
+            heading -= turned;
+        }
+        else
+        {
+            x += length * cos(heading);
+            y += length * sin(heading);
+        }
+        distance -= length;
+    }
+
+    // Past the end
+    if (distance > 0)
+    {
+        x += distance * cos(heading);
+        y += distance * sin(heading);
+    }
+}
+
+/**
+ * @brief courseClearanceAt is how far (up to PATH_CLEARANCE) the robot's centroid at (x, y) is from everything on the course.
+ */
+float courseClearanceAt(float x, float y)
+{
+    float clearance = PATH_CLEARANCE;
+    while (clearance > 0 && courseObstacleAt(x, y, clearance) != -1)
+        clearance -= .25;
+    return clearance;
+}
+
+/**
+ * @brief isPosePathClear checks a path against the course map, from its start to "length" inches along it.
+ */
+bool isPosePathClear(const PosePath &path, float length, const PoseClearance &ends)
+{
+    for (float distance = 0; distance <= length; distance += POSE_CHECK_STEP)
+    {
+        float x, y, heading;
+        posePathPoint(path, distance, x, y, heading);
+
+        float clearance = PATH_CLEARANCE;
+        if (getDistance(x, y, ends.startX, ends.startY) < POSE_NEAR_DISTANCE && ends.startClearance < clearance)
+            clearance = ends.startClearance;
+        if (getDistance(x, y, ends.endX, ends.endY) < POSE_NEAR_DISTANCE && ends.endClearance < clearance)
+            clearance = ends.endClearance;
+
+        if (clearance > 0 && courseObstacleAt(x, y, clearance) != -1)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief planForwardPosePath finds the shortest forwards-only path between two poses (headings in radians) that's clear
+ * of everything on the course, final straight included. path.length comes back -1 if none of them are.
+ */
+void planForwardPosePath(float startX, float startY, float startHeading, float endX, float endY, float endHeading, float radius,
+                         const PoseClearance &ends, PosePath &path)
+{
+    float dx = endX - startX, dy = endY - startY;
+    float d = sqrt(dx * dx + dy * dy) / radius;
+    float theta = wrapRadians(atan2(dy, dx));
+    float alpha = wrapRadians(startHeading - theta), beta = wrapRadians(endHeading - theta);
+
+    path.startX = startX;
+    path.startY = startY;
+    path.startHeading = startHeading;
+    path.radius = radius;
+    path.isReversed = false;
+    path.length = -1;
+
+    for (int word = 0; word < 6; word++)
+    {
+        float pieces[3];
+        if (!findDubinsWord(word, d, alpha, beta, pieces))
+            continue;
+
+        float length = (pieces[0] + pieces[1] + pieces[2]) * radius;
+        if (path.length >= 0 && length >= path.length)
+            continue;
+
+        PosePath candidate = path;
+        candidate.length = length;
+        for (int i = 0; i < 3; i++)
+        {
+            candidate.types[i] = DUBINS_WORDS[word][i];
+            candidate.lengths[i] = pieces[i] * radius;
+        }
+        if (isPosePathClear(candidate, length + POSE_FINAL_STRAIGHT, ends))
+            path = candidate;
+    }
+}
+
+/**
+ * @brief planPosePath finds the shortest clear path from one pose to another (headings in degrees, like everywhere else).
+ * @param canReverse is whether the path is allowed to be driven backwards.
+ */
+void planPosePath(float startX, float startY, float startHeading, float endX, float endY, float endHeading, bool canReverse, PosePath &path)
+{
+    PoseClearance ends = { startX, startY, courseClearanceAt(startX, startY), endX, endY, courseClearanceAt(endX, endY) };
+
+    // Pure pursuit cuts the corner on the last arc, so every path ends on a short straight to give it time to line up
+    float heading = degreeToRadian(endHeading);
+    float beforeX = endX - POSE_FINAL_STRAIGHT * cos(heading), beforeY = endY - POSE_FINAL_STRAIGHT * sin(heading);
+    planForwardPosePath(startX, startY, degreeToRadian(startHeading), beforeX, beforeY, heading, POSE_TURN_RADIUS, ends, path);
+
+    if (canReverse)
+    {
+        // Backwards is forwards with the robot turned around (so the straight at the end comes from the other side)
+        PosePath reversed;
+        float backwards = heading + PI;
+        planForwardPosePath(startX, startY, degreeToRadian(startHeading) + PI, endX + POSE_FINAL_STRAIGHT * cos(heading),
+                            endY + POSE_FINAL_STRAIGHT * sin(heading), backwards, POSE_TURN_RADIUS, ends, reversed);
+        reversed.isReversed = true;
+        if (reversed.length >= 0 && (path.length < 0 || reversed.length < path.length))
+            path = reversed;
+    }
+
+    // The straight is what posePathPoint() does past the end anyway
+    if (path.length >= 0)
+        path.length += POSE_FINAL_STRAIGHT;
+}
+
+/**
+ * @brief followPosePath drives a path with pure pursuit until the robot gets to the end of it.
+ * @param power is the fraction of full motor power to drive at.
+ */
+void followPosePath(const PosePath &path, float power)
+{
+    float endX, endY, endHeading;
+    posePathPoint(path, path.length, endX, endY, endHeading);
+
+    float progress = 0;
+    ProgressMonitor monitor("followPosePath", tuning.controlLoopSleep);
+    Deadline deadline(POSE_TIMEOUT);
+    startTicks(GOTOPOINT_TICK, tuning.controlLoopSleep);
+    while (true)
+    {
+        controlIterations++;
+
+        int rpsWait = loopUntilValidRPS();
+        if (rpsWait == -2)
+        {
+            SD.Printf("followPosePath: Deadzone has become enabled again.\r\n");
+            robot.hasExhaustedDeadzone = true;
+            getBackToRPSFromDeadzone();
+            return;
+        }
+        if (rpsWait == -1)
+        {
+            SD.Printf("followPosePath: No RPS, giving up on this one.\r\n");
+            return;
+        }
+        updateLastValidRPSValues();
+
+        float x = rpsXToCentroidX(), y = rpsYToCentroidY();
+        float heading = degreeToRadian(rpsHeading() + (path.isReversed ? 180 : 0));
+
+        if (getDistance(x, y, endX, endY) < POSE_END_TOLERANCE || progress >= path.length)
+            break;
+        if (deadline.HasPassed())
+        {
+            SD.Printf("followPosePath: Gave up on (%f, %f) after %d seconds.\r\n", endX, endY, POSE_TIMEOUT);
+            break;
+        }
+
+        // Caught on something - Backs off, comes at it from a little to the side, and picks the path back up (see stall.h)
+        if (monitor.IsStalled(x, y) && !recoverFromStall(monitor, path.isReversed ? -1 : 1))
+            break;
+
+        // Where along the path it is - The closest point a little ways ahead of where it was last time
+        float closest = -1;
+        for (float along = progress; along <= progress + 2 * POSE_LOOKAHEAD; along += .25)
+        {
+            float pathX, pathY, pathHeading;
+            posePathPoint(path, along, pathX, pathY, pathHeading);
+            float distance = getDistance(x, y, pathX, pathY);
+            if (closest < 0 || distance < closest)
+            {
+                closest = distance;
+                progress = along;
+            }
+        }
+
+        // The arc through the lookahead point, as a curvature (1 / radius, positive to the left)
+        float targetX, targetY, targetHeading;
+        posePathPoint(path, progress + POSE_LOOKAHEAD, targetX, targetY, targetHeading);
+        float toTarget = atan2(targetY - y, targetX - x) - heading;
+        float targetDistance = getDistance(x, y, targetX, targetY);
+        float curvature = targetDistance > 0 ? 2 * sin(toTarget) / targetDistance : 0;
+
+        // Slows down for the end so it doesn't overshoot
+        float remaining = path.length - progress;
+        float speed = power * (remaining < POSE_SLOW_DOWN_DISTANCE ? .5 + .5 * remaining / POSE_SLOW_DOWN_DISTANCE : 1);
+
+        // Inside wheel slows down and outside wheel speeds up to follow the arc - Capped so neither one goes past a pivot
+        float steer = curvature * TRACK_WIDTH / 2;
+        steer = steer > 1 ? 1 : (steer < -1 ? -1 : steer);
+        float left = speed * (1 - steer), right = speed * (1 + steer);
+
+        // Backwards is the same arc with the wheels swapped and reversed
+        if (path.isReversed)
+        {
+            float swap = left;
+            left = -right;
+            right = -swap;
+        }
+
+        drive.SetWheels(left, right);
+
+        waitForTick(GOTOPOINT_TICK);
+    }
+
+    drive.Stop();
+}
+
+/**
+ * @brief goToPose gets to (endX, endY) facing endHeading in one smooth path, instead of turn-drive-turn.
+ * @param canReverse is whether it's allowed to back the whole way there (the goToPoint fallback backs up too, if that means
+ * less turning).
+ * @param mode is the same as goToPoint's (0 for slow and precise, up from there for faster).
+ */
+void goToPose(float endX, float endY, float endHeading, bool canReverse, int mode)
+{
+    int rpsWait = loopUntilValidRPS();
+    if (rpsWait == -2)
+    {
+        SD.Printf("goToPose: Deadzone has become enabled again.\r\n");
+        robot.hasExhaustedDeadzone = true;
+        getBackToRPSFromDeadzone();
+        return;
+    }
+    if (rpsWait == -1)
+    {
+        SD.Printf("goToPose: No RPS, giving up on this one.\r\n");
+        return;
+    }
+
+    float x = rpsXToCentroidX(), y = rpsYToCentroidY(), heading = rpsHeading();
+    PosePath path;
+    planPosePath(x, y, heading, endX, endY, endHeading, canReverse, path);
+
+    // What turn-drive-turn would cost, in inches of driving - Looping all the way around to get somewhere close by is slower.
+    // Backwards only if it's allowed and means less turning than forwards
+    float forwards = getDesiredHeading(x, y, endX, endY), backwards = rotate180Degrees(forwards);
+    float forwardsTurned = smallestDistanceBetweenHeadings(heading, forwards) + smallestDistanceBetweenHeadings(forwards, endHeading);
+    float backwardsTurned = smallestDistanceBetweenHeadings(heading, backwards) + smallestDistanceBetweenHeadings(backwards, endHeading);
+    bool shouldGoBackwards = canReverse && backwardsTurned < forwardsTurned;
+    float turned = shouldGoBackwards ? backwardsTurned : forwardsTurned;
+    float distance = getDistance(x, y, endX, endY);
+    float turnDriveTurn = distance + turned * POSE_INCHES_PER_DEGREE + 2 * POSE_TURN_OVERHEAD_INCHES;
+    if (path.length < 0 || path.length > turnDriveTurn)
+    {
+        // The straight line gets checked the same way the paths do
+        PosePath straight = { x, y, degreeToRadian(forwards), POSE_TURN_RADIUS, { POSE_STRAIGHT, POSE_STRAIGHT, POSE_STRAIGHT },
+                              { distance, 0, 0 }, distance, false };
+        PoseClearance ends = { x, y, courseClearanceAt(x, y), endX, endY, courseClearanceAt(endX, endY) };
+        if (isPosePathClear(straight, distance, ends))
+        {
+            SD.Printf("goToPose: Path to (%f, %f) would be %f inches - Using goToPoint instead%s.\r\n", endX, endY, path.length,
+                      shouldGoBackwards ? ", backwards" : "");
+            goToPoint(endX, endY, true, endHeading, false, 0.0, shouldGoBackwards, mode);
+        }
+        else
+        {
+            SD.Printf("goToPose: Path to (%f, %f) would be %f inches - Using goToPointPlanned instead.\r\n", endX, endY, path.length);
+            goToPointPlanned(endX, endY, true, endHeading, mode);
+        }
+        return;
+    }
+
+    SD.Printf("goToPose: %f inch path to (%f, %f) facing %f%s.\r\n", path.length, endX, endY, endHeading, path.isReversed ? ", backwards" : "");
+    followPosePath(path, .2 + mode * .1);
+
+    SD.Printf("goToPose: Ended at (%f, %f) facing %f.\r\n", rpsXToCentroidX(), rpsYToCentroidY(), rpsHeading());
+}
+
+#endif // POSEPATH_H
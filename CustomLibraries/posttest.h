@@ -3,11 +3,15 @@
 
 // Imports 
 #include <FEHSD.h> // SD Card Functions
+#include "budget.h"
+#include "scheduler.h"
 
 // Deinitializing systems at the end of a run 
 void deinit()
 {
     SD.Printf("Running deinitialization protocols.\r\n");
+    logSchedulerStats();
+    saveTaskStats();
     SD.CloseLog();
 }
 
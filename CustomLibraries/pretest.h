@@ -2,6 +2,10 @@
 #define SETUP_H
 
 #include <FEHRPS.h>
+#include "battery.h"
+#include "budget.h"
+#include "ddrlight.h"
+#include "motormap.h"
 #include "rps.h"
 #include "utility.h"
 
@@ -13,6 +17,12 @@ void init()
     SD.Printf("Running initialization protocols.\r\n");
     RPS.InitializeTouchMenu();
     SD.OpenLog();
+    startRecordingIfAsked();
+    loadTaskStats();
+    loadMotorMaps();
+
+    // Pre-run battery check - Shows the voltage on the LCD (see battery.h)
+    checkBattery();
 }
 
 // Gets RPS Coordinates - Used to basically negate the minor differences in each course 
@@ -21,68 +31,85 @@ void calibrate()
 {
     SD.Printf("Running initialization procedure.\r\n");
 
+    // Motors - Only if they haven't been fitted yet (see motormap.h), with about 15 inches of room ahead and behind
+    if (!areMotorMapsFitted)
+    {
+        SD.Printf("Touch to fit the motors.\r\n");
+        loopUntilTouch();
+        loopUntilValidRPS();
+        if (fitMotorMaps())
+            saveMotorMaps();
+        Sleep(1.0);
+    }
+
     // Token
     loopUntilTouch();
     loopUntilValidRPS();
-    TOKEN_X = RPS.X();
-    TOKEN_Y = RPS.Y();
-    TOKEN_HEADING = RPS.Heading();
-    SD.Printf("Token X: %f\r\n", TOKEN_X);
-    SD.Printf("Token Y: %f\r\n", TOKEN_Y);
-    SD.Printf("Token Heading: %f\r\n", TOKEN_HEADING);
+    robot.calibration.tokenX = rpsX();
+    robot.calibration.tokenY = rpsY();
+    robot.calibration.tokenHeading = rpsHeading();
+    SD.Printf("Token X: %f\r\n", robot.calibration.tokenX);
+    SD.Printf("Token Y: %f\r\n", robot.calibration.tokenY);
+    SD.Printf("Token Heading: %f\r\n", robot.calibration.tokenHeading);
+
+    // Nowhere near the DDR lights, so this is what the light sensor reads when there's no light under it (see ddrlight.h)
+    captureUnlitLightLevel();
     Sleep(1.0);
 
     // DDR Blue (Far) Button
     loopUntilTouch();
     loopUntilValidRPS();
-    DDR_BLUE_LIGHT_X = RPS.X();
-    DDR_LIGHT_Y = RPS.Y();
-    SD.Printf("DDR Blue X: %f\r\n", DDR_BLUE_LIGHT_X);
-    SD.Printf("DDR Y: %f\r\n", DDR_LIGHT_Y);
+    robot.calibration.ddrBlueLightX = rpsX();
+    robot.calibration.ddrLightY = rpsY();
+    SD.Printf("DDR Blue X: %f\r\n", robot.calibration.ddrBlueLightX);
+    SD.Printf("DDR Y: %f\r\n", robot.calibration.ddrLightY);
+
+    // Sitting on the blue light - If it's lit right now, that's the blue level
+    captureDDRLightLevel();
     Sleep(1.0);
 
     // RPS Button
     loopUntilTouch();
     loopUntilValidRPS();
-    RPS_BUTTON_X = RPS.X();
-    RPS_BUTTON_Y = RPS.Y();
-    RPS_BUTTON_HEADING = RPS.Heading();
-    SD.Printf("RPS Button X: %f\r\n", RPS_BUTTON_X);
-    SD.Printf("RPS Button Y: %f\r\n", RPS_BUTTON_Y);
-    SD.Printf("RPS Button Heading: %f\r\n", RPS_BUTTON_HEADING);
+    robot.calibration.rpsButtonX = rpsX();
+    robot.calibration.rpsButtonY = rpsY();
+    robot.calibration.rpsButtonHeading = rpsHeading();
+    SD.Printf("RPS Button X: %f\r\n", robot.calibration.rpsButtonX);
+    SD.Printf("RPS Button Y: %f\r\n", robot.calibration.rpsButtonY);
+    SD.Printf("RPS Button Heading: %f\r\n", robot.calibration.rpsButtonHeading);
     Sleep(1.0);
 
     // Foosball Start
     // Todo - Measure how far the right side is from the left side to eliminate a sampling point 
     loopUntilTouch();
     loopUntilValidRPS();
-    FOOSBALL_START_X = RPS.X();
-    FOOSBALL_START_Y = RPS.Y();
-    SD.Printf("Foosball Start X: %f\r\n", FOOSBALL_START_X);
-    SD.Printf("Foosball Start Y: %f\r\n", FOOSBALL_START_Y);
+    robot.calibration.foosballStartX = rpsX();
+    robot.calibration.foosballStartY = rpsY();
+    SD.Printf("Foosball Start X: %f\r\n", robot.calibration.foosballStartX);
+    SD.Printf("Foosball Start Y: %f\r\n", robot.calibration.foosballStartY);
     Sleep(1.0);
 
     // Foosball width is constant across courses, so we can just apply an offset to the start position to get the end position
     const float FOOSBALL_HORIZONTAL_DISTANCE = 10;
-    FOOSBALL_END_X = FOOSBALL_START_X - FOOSBALL_HORIZONTAL_DISTANCE;
+    robot.calibration.foosballEndX = robot.calibration.foosballStartX - FOOSBALL_HORIZONTAL_DISTANCE;
 
     // Making the logical assumption that start and end are at the same height (as they need to be for the robot to go 180 degrees backwards, parallel to foosball)
-    FOOSBALL_END_Y = FOOSBALL_START_Y;
+    robot.calibration.foosballEndY = robot.calibration.foosballStartY;
 
     // Lever
     // Todo - Figure out the best place to do lever from 
     loopUntilTouch();
     loopUntilValidRPS();
-    LEVER_X = RPS.X();
-    LEVER_Y = RPS.Y();
-    LEVER_HEADING = RPS.Heading();
-    SD.Printf("Lever X: %f\r\n", LEVER_X);
-    SD.Printf("Lever Y: %f\r\n", LEVER_Y);
+    robot.calibration.leverX = rpsX();
+    robot.calibration.leverY = rpsY();
+    robot.calibration.leverHeading = rpsHeading();
+    SD.Printf("Lever X: %f\r\n", robot.calibration.leverX);
+    SD.Printf("Lever Y: %f\r\n", robot.calibration.leverY);
     Sleep(1.0);
 
     // Preparation for next program step
-    armServo.SetDegree(30);
-    clearLCD();
+    robot.hardware.armServo.SetDegree(30);
+    clearStatusDisplay();
 }
 
 #endif
@@ -0,0 +1,151 @@
+#ifndef PUSH_H
+#define PUSH_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// Custom Libraries
+#include "constants.h"
+#include "deadline.h"
+#include "drive.h"
+#include "scheduler.h"
+#include "utility.h"
+
+/*
+ * Pushes that know when they've hit something. pushUntilContact() drives straight until the bump switch on the front
+ * closes - Or, if the switch misses (hitting at an angle), until RPS says the robot stopped getting anywhere. Either way it
+ * reports when contact happened, so a hold on a button (holdPush()) can be timed from the moment the button went down
+ * instead of padding the hold for however long the drive there might take.
+ *
+ * On the way it holds the heading it started at, with the same proportional steer climbRamp() uses (ramp.h), so a
+ * slightly uneven pair of wheels doesn't curve it off the button. It also keeps robot.lastValid up to date, so anything
+ * sampling in the background (the DDR light) knows where the robot is, and it can be told to stop partway (shouldStop)
+ * when the push turns out to be headed for the wrong thing.
+ */
+
+#define PUSH_TICK_PERIOD .01        // Seconds between checks
+#define PUSH_STALL_WINDOW .3        // Seconds it gets to make PUSH_STALL_DISTANCE worth of progress before it counts as stopped
+#define PUSH_STALL_DISTANCE .2      // Inches
+#define PUSH_TIMEOUT 5              // Seconds before it gives up on ever hitting anything
+#define PUSH_HEADING_GAIN .02       // Turn power per degree off the starting heading - Same as the ramp's
+#define PUSH_MAX_STEER .3           // Most turn power the heading hold uses
+
+/**
+ * @brief isBumpSwitchPressed reads the bump switch on the front of the robot. Switches read low while they're pressed.
+ */
+bool isBumpSwitchPressed() { return !robot.hardware.bumpSwitch.Value(); }
+
+// How a push ended
+struct PushResult
+{
+    bool hasContact;        // Bump switch closed
+    bool isStalled;         // Stopped making progress without the switch closing
+    double contactTime;     // timeNow() when either happened (when it gave up, if neither did)
+};
+
+/**
+ * @brief pushUntilContact drives straight at the given speed (negative for backwards), holding the heading it started at,
+ * until it's up against something. Leaves the motors running - Follow it up with holdPush() or drive.Stop().
+ * @param shouldStop gets asked every tick, if there is one - The push ends (with no contact) as soon as it says yes.
+ */
+PushResult pushUntilContact(float speed, bool (*shouldStop)() = 0)
+{
+    PushResult result = { false, false, 0 };
+    double startTime = timeNow();
+    Deadline deadline(PUSH_TIMEOUT);
+
+    // Start of the current stall window
+    float windowX = rpsX(), windowY = rpsY();
+    double windowStart = startTime;
+
+    // Heading to hold - Without RPS there's nothing to hold it against, so it just goes straight
+    float holdHeading = rpsHeading();
+    float steer = 0;
+    bool wasStopped = false;
+
+    drive.Set(speed, 0);
+    startTicks(PUSH_TICK, PUSH_TICK_PERIOD);
+    while (!deadline.HasPassed())
+    {
+        double now = timeNow();
+        if (isBumpSwitchPressed())
+        {
+            result.hasContact = true;
+            break;
+        }
+
+        if (shouldStop && shouldStop())
+        {
+            wasStopped = true;
+            break;
+        }
+
+        // Where it is, for anything sampling in the background
+        float x = rpsX(), y = rpsY(), heading = rpsHeading();
+        if (x >= 0 && y >= 0 && heading >= 0)
+        {
+            robot.lastValid.x = x;
+            robot.lastValid.y = y;
+            robot.lastValid.heading = heading;
+        }
+
+        // Heading hold - Turning back towards the starting heading, harder the further off it is (left is positive)
+        if (holdHeading >= 0 && heading >= 0)
+        {
+            float error = smallestDistanceBetweenHeadings(heading, holdHeading);
+            if (!shouldTurnLeft(heading, holdHeading))
+                error = -error;
+            steer = PUSH_HEADING_GAIN * error;
+            steer = steer > PUSH_MAX_STEER ? PUSH_MAX_STEER : (steer < -PUSH_MAX_STEER ? -PUSH_MAX_STEER : steer);
+        }
+        drive.Set(speed, steer);
+
+        // Checking in on progress once a window - A window without RPS at both ends just doesn't count
+        if (now - windowStart >= PUSH_STALL_WINDOW)
+        {
+            bool hasRPS = x >= 0 && y >= 0 && windowX >= 0 && windowY >= 0;
+            if (hasRPS && getDistance(windowX, windowY, x, y) < PUSH_STALL_DISTANCE)
+            {
+                result.isStalled = true;
+                break;
+            }
+
+            windowX = x;
+            windowY = y;
+            windowStart = now;
+        }
+
+        waitForTick(PUSH_TICK);
+    }
+
+    result.contactTime = timeNow();
+    if (result.hasContact)
+        SD.Printf("pushUntilContact: Bump switch closed %f s in.\r\n", result.contactTime - startTime);
+    else if (result.isStalled)
+        SD.Printf("pushUntilContact: Stopped moving %f s in, without the bump switch.\r\n", result.contactTime - startTime);
+    else if (wasStopped)
+        SD.Printf("pushUntilContact: Told to stop %f s in, before hitting anything.\r\n", result.contactTime - startTime);
+    else
+        SD.Printf("pushUntilContact: Never hit anything in %d s.\r\n", PUSH_TIMEOUT);
+    return result;
+}
+
+/**
+ * @brief holdPush keeps pushing at the given speed until holdSeconds after the push made contact, then stops. If the push
+ * never made contact there's nothing to hold, so it just stops.
+ */
+void holdPush(float speed, const PushResult &push, float holdSeconds)
+{
+    if (!push.hasContact && !push.isStalled)
+    {
+        SD.Printf("holdPush: No contact, not holding.\r\n");
+        drive.Stop();
+        return;
+    }
+
+    drive.Set(speed, 0);
+    sleepUntil(push.contactTime + holdSeconds);
+    drive.Stop();
+}
+
+#endif // PUSH_H
@@ -0,0 +1,127 @@
+#ifndef RAMP_H
+#define RAMP_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "deadline.h"
+#include "navigation.h"
+#include "pathplanner.h"
+#include "stall.h"
+
+/*
+ * Ramp climb. Going up the ramp used to be two goToPoints at mode 5 - One to partway up, one to the top - But on the
+ * slope the same power gets the robot a lot less speed, so goToPoint's tiered corrections (which were tuned on the flat)
+ * would over- or under-steer, and it stopped dead at the middle point for no reason but to line back up.
+ *
+ * climbRamp() drives straight up the ramp's axis (north) from the bottom to the top in one pass:
+ *  - Heading hold - Steers towards the point on the axis RAMP_LOOKAHEAD further up, with the turn proportional to how far
+ *    off the heading is, so it stays on the ramp's axis instead of zig-zagging between correction tiers
+ *  - Power feedforward - There's no tilt sensor, so the pitch comes from the pose: while RPS puts the robot on the ramp
+ *    (isOnRamp() in pathplanner.h), the part of its heading that points up the slope is how much it's climbing, and the
+ *    power goes up by that much times RAMP_FEEDFORWARD to make up for the speed the slope takes away
+ *  - Getting on and off the ramp is just the pose crossing the edge of the ramp's box, and both get logged
+ *
+ * Stalls (the lip at the bottom, mostly) get handled the same way goToPoint handles them (stall.h).
+ */
+
+#define RAMP_POWER .7                   // Fraction of full power on the flat - Same as goToPoint's RampSpeed cruise
+#define RAMP_FEEDFORWARD .45            // Extra power per unit of climb (sin of the heading up the slope) while on the ramp
+#define RAMP_LOOKAHEAD 4                // Inches along the line ahead of the robot that it steers towards
+#define RAMP_HEADING_GAIN .02           // Turn power per degree off
+#define RAMP_MAX_STEER .3               // Most turn power the heading hold uses
+#define RAMP_MAX_HEADING_ERROR 30       // Degrees off at the start that gets a turn in place first
+#define RAMP_END_TOLERANCE 2            // Inches from the top that counts as there - Same as goToPoint's RampSpeed
+#define RAMP_SLOW_DOWN_DISTANCE 4       // Inches from the top where it starts slowing down
+#define RAMP_TIMEOUT 10                 // Seconds before it gives up
+
+/**
+ * @brief climbRamp drives north up the ramp along x = axisX, from wherever the robot is now (the bottom) to topY, without
+ * stopping. It doesn't have to start on the line - It merges onto it over the first few inches.
+ */
+void climbRamp(float axisX, float topY)
+{
+    float startY = rpsYToCentroidY();
+    SD.Printf("climbRamp: End (x, y): (%f, %f), starting from y = %f.\r\n", axisX, topY, startY);
+    if (topY - startY < RAMP_END_TOLERANCE)
+        return;
+
+    if (smallestDistanceBetweenHeadings(rpsHeading(), NORTH) > RAMP_MAX_HEADING_ERROR)
+        turn(NORTH);
+
+    bool isOnRampNow = false;
+    ProgressMonitor progress("climbRamp", tuning.controlLoopSleep);
+    Deadline deadline(RAMP_TIMEOUT);
+    startTicks(GOTOPOINT_TICK, tuning.controlLoopSleep);
+    while (true)
+    {
+        controlIterations++;
+
+        int rpsWait = loopUntilValidRPS();
+        if (rpsWait == -2)
+        {
+            SD.Printf("climbRamp: Deadzone has become enabled again.\r\n");
+            robot.hasExhaustedDeadzone = true;
+            getBackToRPSFromDeadzone();
+            return;
+        }
+        if (rpsWait == -1)
+        {
+            SD.Printf("climbRamp: No RPS, giving up on this one.\r\n");
+            return;
+        }
+        updateLastValidRPSValues();
+
+        float x = rpsXToCentroidX(), y = rpsYToCentroidY(), heading = rpsHeading();
+
+        // Only how far up it's gotten counts - Being off to the side at the top is the heading hold's problem, not a
+        // reason to turn around
+        float remaining = topY - y;
+        if (remaining < RAMP_END_TOLERANCE)
+            break;
+        if (deadline.HasPassed())
+        {
+            SD.Printf("climbRamp: Gave up on y = %f after %d seconds.\r\n", topY, RAMP_TIMEOUT);
+            break;
+        }
+
+        if (isOnRamp(x, y) != isOnRampNow)
+        {
+            isOnRampNow = !isOnRampNow;
+            SD.Printf("climbRamp: %s the ramp at (%f, %f), %f s in.\r\n", isOnRampNow ? "Onto" : "Off of", x, y,
+                      deadline.SecondsElapsed());
+        }
+
+        if (progress.IsStalled(x, y) && !recoverFromStall(progress, 1))
+            break;
+
+        // Heading hold - Towards the point on the axis RAMP_LOOKAHEAD further up, turning harder the further off it is
+        float lookaheadY = y + RAMP_LOOKAHEAD > topY ? topY : y + RAMP_LOOKAHEAD;
+        float desiredHeading = getDesiredHeading(x, y, axisX, lookaheadY);
+        float error = smallestDistanceBetweenHeadings(heading, desiredHeading);
+        if (!shouldTurnLeft(heading, desiredHeading))
+            error = -error;
+        float steer = RAMP_HEADING_GAIN * error;
+        steer = steer > RAMP_MAX_STEER ? RAMP_MAX_STEER : (steer < -RAMP_MAX_STEER ? -RAMP_MAX_STEER : steer);
+
+        // Feedforward for the slope - Facing straight up it gets all of it, across it none
+        float climb = isOnRampNow ? sin(degreeToRadian(heading)) : 0;
+        float power = RAMP_POWER * (1 + RAMP_FEEDFORWARD * climb);
+        if (remaining < RAMP_SLOW_DOWN_DISTANCE)
+            power *= .5 + .5 * remaining / RAMP_SLOW_DOWN_DISTANCE;
+        if (power + fabs(steer) > 1)
+            power = 1 - fabs(steer);
+
+        drive.Set(power, steer);
+        waitForTick(GOTOPOINT_TICK);
+    }
+
+    drive.Stop();
+    SD.Printf("climbRamp: Done at (%f, %f), %f s in.\r\n", rpsXToCentroidX(), rpsYToCentroidY(), deadline.SecondsElapsed());
+}
+
+#endif // RAMP_H
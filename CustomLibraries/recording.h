@@ -0,0 +1,161 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+// FEH Libraries
+#include <FEHBattery.h>
+#include <FEHMotor.h>
+#include <FEHServo.h>
+#include <FEHIO.h>
+#include <FEHRPS.h>
+#include <FEHLCD.h>
+#include <FEHSD.h>
+
+// No custom library imports - constants.h needs this before it declares any of the hardware
+
+// Marks a global that belongs to the robot rather than to the program. Means nothing on the Proteus (there's only ever the
+// one robot), but the simulator makes these thread_local so every simulation thread runs a robot of its own (see backend.h)
+#ifndef ROBOT_STATE
+#define ROBOT_STATE
+#endif
+
+/*
+ * Recording mode. Every input the robot acts on (RPS, light sensor, bump switch, encoders, screen touches, clock reads, battery) and every
+ * output it gives (motor percents, servo degrees) gets written to the SD log as a "REC" line, in the order it happened:
+ *
+ *     REC <type> <seconds since boot> <value> [<touch x> <touch y>]
+ *
+ * Types: X/Y/H = RPS x/y/heading, A = light sensor, B = bump switch, E/F = left/right encoder counts, T = screen touch,
+ *        C = clock read, V = battery voltage, L/R = left/right motor percent, S = arm servo degree
+ *
+ * Simulator/replay.cpp pulls those lines back out of the log and feeds the inputs back into the same code on a computer,
+ * so we can see exactly what goToPoint decided and when, and diff its motor commands against what the robot really did.
+ *
+ * Clock reads get written with every digit a double has. Deadlines and ticks compare times right down to the last digit,
+ * so a replay fed rounded times makes different calls the first time one lands right on a boundary.
+ *
+ * Recording is off unless there's a RECORDING_FLAG_FILE on the SD card - It's an SD line for every read, tens of thousands
+ * a run, and each one blocks. Put the file on the card for runs worth replaying.
+ */
+
+#define RECORDING_FLAG_FILE "RECORD.TXT"
+
+// Turned on by startRecordingIfAsked() (or by a simulator tool that wants a log to replay)
+ROBOT_STATE bool isRecording = false;
+
+// Set by Simulator/replay.cpp - Playing a recording back never records a new one, and skips whatever wasn't recorded
+ROBOT_STATE bool isReplaying = false;
+
+void recordEvent(char type, float value)
+{
+    if (isRecording)
+        SD.Printf("REC %c %f %f\r\n", type, TimeNow(), value);
+}
+
+/**
+ * @brief startRecordingIfAsked turns recording on if there's a RECORDING_FLAG_FILE on the SD card. Goes in init(), right
+ * after the log gets opened.
+ */
+void startRecordingIfAsked()
+{
+    if (isReplaying)
+        return;
+
+    FEHFile *file = SD.FOpen(RECORDING_FLAG_FILE, "r");
+    if (!file)
+        return;
+    SD.FClose(file);
+
+    isRecording = true;
+    SD.Printf("Recording: %s is on the SD card, recording this run.\r\n", RECORDING_FLAG_FILE);
+}
+
+// RPS reads - Use these instead of RPS.X(), etc. so that they end up in the recording
+float rpsX() { float value = RPS.X(); recordEvent('X', value); return value; }
+float rpsY() { float value = RPS.Y(); recordEvent('Y', value); return value; }
+float rpsHeading() { float value = RPS.Heading(); recordEvent('H', value); return value; }
+
+// Clock reads - Anything that makes decisions off of the time has to go through this, otherwise replays drift
+double timeNow()
+{
+    double value = TimeNow();
+    if (isRecording)
+        SD.Printf("REC C %.9f %.9f\r\n", value, value);
+    return value;
+}
+
+// Battery reads - Motor output gets scaled off of these (see battery.h), so they have to be in the recording too
+float batteryVoltage() { float value = Battery.Voltage(); recordEvent('V', value); return value; }
+
+// Screen touches - Use instead of LCD.Touch()
+bool lcdTouch(float *x, float *y)
+{
+    bool touched = LCD.Touch(x, y);
+    if (isRecording)
+        SD.Printf("REC T %f %d %f %f\r\n", TimeNow(), touched, *x, *y);
+    return touched;
+}
+
+/**
+ * @brief RecordedMotor is a drop-in FEHMotor that logs every command it gets.
+ */
+class RecordedMotor : public FEHMotor
+{
+public:
+    RecordedMotor(FEHMotorPort port, float maxVoltage, char type) : FEHMotor(port, maxVoltage), recordType(type) {}
+    void SetPercent(float percent) { recordEvent(recordType, percent); FEHMotor::SetPercent(percent); }
+    void Stop() { recordEvent(recordType, 0); FEHMotor::Stop(); }
+
+private:
+    char recordType;
+};
+
+/**
+ * @brief RecordedServo is a drop-in FEHServo that logs every command it gets, and remembers the last one.
+ */
+class RecordedServo : public FEHServo
+{
+public:
+    RecordedServo(FEHServoPort port) : FEHServo(port), lastDegree(0) {}
+    void SetDegree(float degree) { recordEvent('S', degree); lastDegree = degree; FEHServo::SetDegree(degree); }
+
+    // Where the servo was last told to go (it may not have gotten there yet)
+    float LastDegree() { return lastDegree; }
+
+private:
+    float lastDegree;
+};
+
+/**
+ * @brief RecordedAnalogInputPin is a drop-in AnalogInputPin that logs every value it reads.
+ */
+class RecordedAnalogInputPin : public AnalogInputPin
+{
+public:
+    RecordedAnalogInputPin(FEHIO::FEHIOPin pin) : AnalogInputPin(pin) {}
+    float Value() { float value = AnalogInputPin::Value(); recordEvent('A', value); return value; }
+};
+
+/**
+ * @brief RecordedDigitalInputPin is a drop-in DigitalInputPin that logs every value it reads.
+ */
+class RecordedDigitalInputPin : public DigitalInputPin
+{
+public:
+    RecordedDigitalInputPin(FEHIO::FEHIOPin pin) : DigitalInputPin(pin) {}
+    bool Value() { bool value = DigitalInputPin::Value(); recordEvent('B', value); return value; }
+};
+
+/**
+ * @brief RecordedDigitalEncoder is a drop-in DigitalEncoder that logs every count it reads.
+ */
+class RecordedDigitalEncoder : public DigitalEncoder
+{
+public:
+    RecordedDigitalEncoder(FEHIO::FEHIOPin pin, char type) : DigitalEncoder(pin), recordType(type) {}
+    int Counts() { int value = DigitalEncoder::Counts(); recordEvent(recordType, value); return value; }
+
+private:
+    char recordType;
+};
+
+#endif // RECORDING_H
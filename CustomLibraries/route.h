@@ -0,0 +1,33 @@
+#ifndef ROUTE_H
+#define ROUTE_H
+
+// No imports needed - Just numbers
+
+/*
+ * Every in-between point finalRoutine drives through that isn't a task station itself. Most are offsets from a calibrated
+ * station so they follow the course around; the ones that don't depend on a station are absolute RPS coordinates.
+ *
+ * Points that were only there to get around something are gone - goToPointPlanned() (pathplanner.h) finds those now.
+ * So are points that only lined the robot up for a station it can curve into with goToPose() (posepath.h).
+ * What's left are points that line the robot up a certain way, or that the ramp needs.
+ *
+ * These were picked by hand. Simulator/routeopt.cpp searches for faster ones that still don't hit anything and prints
+ * a new RouteWaypoints to paste in below.
+ */
+struct RouteWaypoints
+{
+    float ddrStagingY;                          // Offset above the lights - Where we turn to face the buttons
+    float rampBottomX, rampBottomY;             // Offset from the blue light - Bottom of the ramp
+    float rampTopX, rampTopY;                   // x is an offset from the blue light, y is absolute - Top of the ramp
+    float leverApproachX, leverApproachY;       // Offset from the lever - Fast approach before the slow, precise one
+};
+
+ROBOT_STATE RouteWaypoints route =
+{
+    5,
+    0, 2,
+    1.8, 57,
+    1, -4
+};
+
+#endif // ROUTE_H
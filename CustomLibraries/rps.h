@@ -3,32 +3,45 @@
 
 // Imports
 #include <FEHRPS.h>
+#include "deadline.h"
+#include "drive.h"
+#include "scheduler.h"
+
+// Seconds to wait for RPS to come back before giving up on whatever move is waiting on it
+#define RPS_WAIT_TIMEOUT 3
 
 // Updates global variables, but only to "valid" vales (anything that's not "no rps" or a deadzone value)
 void updateLastValidRPSValues()
 {
-    if (RPS.X() != -1 && RPS.X() != -2)
-        lastValidX = RPS.X();
-    if (RPS.Y() != -1 && RPS.Y() != -2)
-        lastValidY = RPS.Y();
-    if (RPS.Heading() != -1 && RPS.Heading() != -2)
-        lastValidHeading = RPS.Heading();
+    if (rpsX() != -1 && rpsX() != -2)
+        robot.lastValid.x = rpsX();
+    if (rpsY() != -1 && rpsY() != -2)
+        robot.lastValid.y = rpsY();
+    if (rpsHeading() != -1 && rpsHeading() != -2)
+        robot.lastValid.heading = rpsHeading();
+
+    setStatusNumber(STATUS_X, "X", robot.lastValid.x);
+    setStatusNumber(STATUS_Y, "Y", robot.lastValid.y);
+    setStatusNumber(STATUS_HEADING, "Heading", robot.lastValid.heading);
 }
 
 // Sensing invalid RPS 
 int rpsState() 
 { 
-    if (RPS.X() == -1 || RPS.Y() == -1 || RPS.Heading() == -1)
+    if (rpsX() == -1 || rpsY() == -1 || rpsHeading() == -1)
         return -1;
-    else if (RPS.X() == -2 || RPS.Y() == -2 || RPS.Heading() == -2)
+    else if (rpsX() == -2 || rpsY() == -2 || rpsHeading() == -2)
         return -2;
     return 0;
 }
 
-// Return value of 0 indicates valid operation, -2 indicates it's in a deadzone 
+// Return value of 0 indicates valid operation, -2 indicates it's in a deadzone, -1 means it gave up waiting (RPS_WAIT_TIMEOUT)
+// The robot sits still while it waits, and callers give up on their move on -1 - Steering off of -1s would send it anywhere
 int loopUntilValidRPS()
 {
     int iterations = 0;
+    Deadline deadline(RPS_WAIT_TIMEOUT);
+    startTicks(RPS_WAIT_TICK, .01);
     while (rpsState() == -1 || rpsState() == -2)
     {
         if (rpsState() == -2)
@@ -36,10 +49,19 @@ int loopUntilValidRPS()
             return -2;
         }
 
+        if (iterations == 0)
+            drive.Stop();
+
+        if (deadline.HasPassed())
+        {
+            SD.Printf("loopUntilValidRPS: No RPS after %d seconds - Giving up on this move.\r\n", RPS_WAIT_TIMEOUT);
+            return -1;
+        }
+
         iterations++;
         SD.Printf("Current iterations looping for RPS: %d\r\n", iterations);
 
-        Sleep(.01);
+        waitForTick(RPS_WAIT_TICK);
     }
 
     // Getting through that loop and not returning by this point indicates that it now has RPS 
@@ -0,0 +1,217 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+// FEH Libraries
+#include <FEHLCD.h>
+#include <FEHSD.h>
+#include <FEHUtility.h>
+
+// Custom Libraries
+#include "constants.h"
+#include "display.h"
+
+/*
+ * Small cooperative scheduler, so loops run at the rate they're meant to instead of "Sleep() plus however long the loop took".
+ *
+ * There are two kinds of periodic tasks in the table below:
+ *  - Ticks (no function) - A control loop calls startTicks() before it starts and waitForTick() at the bottom of every pass.
+ *    waitForTick() waits until the next multiple of the period after the loop started, so the time the loop itself took
+ *    doesn't get added on top.
+ *  - Background tasks (with a function) - Get called whenever they're due, from inside waitForTick() and schedulerSleep().
+ *    Nothing runs them while the code is in a plain Sleep(), so anything that waits a while should use schedulerSleep().
+ *
+ * Every task keeps track of how late it ran (jitter) and how often it missed its deadline, and logSchedulerStats() dumps
+ * all of that to the SD log at the end of a run. A tick misses its deadline when the loop took longer than the period;
+ * a background task misses when it ran more than a full period late.
+ *
+ * All time reads go through timeNow() so that replays see the same clock the robot did.
+ */
+
+// Shortest Sleep() worth doing - The Proteus only sleeps in whole milliseconds
+#define SCHEDULER_MIN_SLEEP .001
+
+struct PeriodicTask
+{
+    const char *name;
+    void (*run)();              // 0 for ticks
+    float period;               // Seconds
+    bool isEnabled;
+
+    // When it's next due (the "release"), in seconds since boot
+    double nextRelease;
+
+    // Stats
+    unsigned long runs, deadlineMisses;
+    double totalJitter;
+    float worstJitter;
+};
+
+void writeTelemetry();
+void stepArm();    // arm.h
+void stepDrive();  // drive.h
+void readBattery();  // battery.h
+void stepOdometry();  // odometry.h
+void sampleDDRLight();  // ddrlight.h
+
+// Order has to match the enum below
+ROBOT_STATE PeriodicTask periodicTasks[] =
+{
+    // Each is { name, run, period, isEnabled, nextRelease, runs, deadlineMisses, totalJitter, worstJitter }
+
+    // Ticks - The periods here get overwritten by startTicks()
+    { "goToPoint", 0, .025, true, 0, 0, 0, 0, 0 },
+    { "turn", 0, .01, true, 0, 0, 0, 0, 0 },
+    { "RPS wait", 0, .01, true, 0, 0, 0, 0, 0 },
+    { "start light", 0, .005, true, 0, 0, 0, 0, 0 },
+    { "odometry move", 0, .02, true, 0, 0, 0, 0, 0 },
+    { "push", 0, .01, true, 0, 0, 0, 0, 0 },
+
+    // Background tasks
+    { "telemetry", writeTelemetry, .1, true, 0, 0, 0, 0, 0 },
+    { "LCD", refreshStatusDisplay, .25, true, 0, 0, 0, 0, 0 },
+    { "arm", stepArm, .01, false, 0, 0, 0, 0, 0 },           // Only on while the arm is busy (see arm.h)
+    { "drive", stepDrive, .01, false, 0, 0, 0, 0, 0 },       // Only on while the wheels are still speeding up (see drive.h)
+    { "battery", readBattery, .5, true, 0, 0, 0, 0, 0 },
+    { "odometry", stepOdometry, .02, false, 0, 0, 0, 0, 0 }, // Only on while something's using odometry (see odometry.h)
+    { "DDR light", sampleDDRLight, .02, false, 0, 0, 0, 0, 0 } // Only on while driving over the DDR lights (see ddrlight.h)
+};
+enum
+{
+    GOTOPOINT_TICK, TURN_TICK, RPS_WAIT_TICK, START_LIGHT_TICK, ODOMETRY_TICK, PUSH_TICK,
+    TELEMETRY_TASK, LCD_TASK, ARM_TASK, DRIVE_TASK, BATTERY_TASK, ODOMETRY_TASK, DDR_LIGHT_TASK, PERIODIC_TASK_COUNT
+};
+
+/**
+ * @brief writeTelemetry logs where the robot last knew it was and what it was telling the motors, a few times a second.
+ */
+void writeTelemetry()
+{
+    SD.Printf("Telemetry: %f %f %f %f %f\r\n", robot.lastValid.x, robot.lastValid.y, robot.lastValid.heading, robot.leftMotorPercent, robot.rightMotorPercent);
+}
+
+// Updates a task's stats for one run that started "lateness" seconds after it was due
+void recordTaskRun(PeriodicTask &task, double lateness, bool missedDeadline)
+{
+    if (lateness < 0)
+        lateness = 0;
+
+    task.runs++;
+    task.totalJitter += lateness;
+    if (lateness > task.worstJitter)
+        task.worstJitter = lateness;
+    if (missedDeadline)
+        task.deadlineMisses++;
+}
+
+/**
+ * @brief runDueTasks runs every background task that's due.
+ * @return Whether anything ran (so the caller knows its idea of the time is stale).
+ */
+bool runDueTasks(double now)
+{
+    bool ranSomething = false;
+    for (int i = 0; i < PERIODIC_TASK_COUNT; i++)
+    {
+        PeriodicTask &task = periodicTasks[i];
+        if (!task.run || !task.isEnabled || now < task.nextRelease)
+            continue;
+
+        recordTaskRun(task, now - task.nextRelease, now - task.nextRelease > task.period);
+        task.run();
+        ranSomething = true;
+
+        // If it fell more than a whole period behind, skip ahead rather than running it several times in a row
+        task.nextRelease += task.period;
+        if (task.nextRelease <= now)
+            task.nextRelease = now + task.period;
+    }
+    return ranSomething;
+}
+
+/**
+ * @brief sleepUntil waits until the given time, running background tasks as they come due.
+ * @return The time it actually woke up.
+ */
+double sleepUntil(double until)
+{
+    double now = timeNow();
+    while (true)
+    {
+        if (runDueTasks(now))
+            now = timeNow();
+        if (now >= until)
+            return now;
+
+        // Sleep until whichever comes first - the end, or the next background task
+        double wake = until;
+        for (int i = 0; i < PERIODIC_TASK_COUNT; i++)
+            if (periodicTasks[i].run && periodicTasks[i].isEnabled && periodicTasks[i].nextRelease < wake)
+                wake = periodicTasks[i].nextRelease;
+
+        Sleep((float) (wake - now > SCHEDULER_MIN_SLEEP ? wake - now : SCHEDULER_MIN_SLEEP));
+        now = timeNow();
+    }
+}
+
+/**
+ * @brief schedulerSleep is Sleep(), except background tasks keep running in the meantime.
+ */
+void schedulerSleep(float seconds) { sleepUntil(timeNow() + seconds); }
+
+/**
+ * @brief startTicks sets up a control loop's tick. Call it right before the loop - the first tick is one period from now.
+ */
+void startTicks(int tick, float period)
+{
+    periodicTasks[tick].period = period;
+    periodicTasks[tick].nextRelease = timeNow() + period;
+}
+
+/**
+ * @brief waitForTick goes at the bottom of a control loop. It waits (running background tasks) until the loop's next tick.
+ * If this pass of the loop already took longer than a period, that's a deadline miss, and the next pass starts right away.
+ */
+void waitForTick(int tick)
+{
+    PeriodicTask &task = periodicTasks[tick];
+    double now = timeNow();
+
+    if (now > task.nextRelease)
+    {
+        recordTaskRun(task, now - task.nextRelease, true);
+        task.nextRelease = now + task.period;
+        runDueTasks(now);
+        return;
+    }
+
+    now = sleepUntil(task.nextRelease);
+    recordTaskRun(task, now - task.nextRelease, false);
+    task.nextRelease += task.period;
+}
+
+/**
+ * @brief restartBackgroundTasks makes every background task that's on due right now, as if they'd all just been started.
+ * For after a wait that didn't get recorded (see startlight.h), so a replay runs them at the same times the robot did.
+ */
+void restartBackgroundTasks(double now)
+{
+    for (int i = 0; i < PERIODIC_TASK_COUNT; i++)
+        if (periodicTasks[i].run && periodicTasks[i].isEnabled)
+            periodicTasks[i].nextRelease = now;
+}
+
+/**
+ * @brief logSchedulerStats writes how on-time every task was to the SD log.
+ */
+void logSchedulerStats()
+{
+    SD.Printf("Scheduler stats:\r\n");
+    for (int i = 0; i < PERIODIC_TASK_COUNT; i++)
+    {
+        PeriodicTask &task = periodicTasks[i];
+        SD.Printf("Scheduler: %s - %d runs, %d deadline misses, average jitter %f s, worst jitter %f s\r\n", task.name,
+                  (int) task.runs, (int) task.deadlineMisses, task.runs > 0 ? task.totalJitter / task.runs : 0.0, task.worstJitter);
+    }
+}
+
+#endif // SCHEDULER_H
@@ -0,0 +1,141 @@
+#ifndef STALL_H
+#define STALL_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// C/C++ Libraries
+#include <cmath>
+
+// Custom Libraries
+#include "constants.h"
+#include "drive.h"
+#include "odometry.h"
+#include "utility.h"
+
+/*
+ * Stall detection. Every so often the robot catches on something - The lip of the ramp, mostly - and whatever was driving
+ * it just keeps pushing until it gets free by chance. ProgressMonitor watches how far the robot has really gone against
+ * whether it's being told to drive, over a sliding window: if the wheels have been told to go for a whole STALL_WINDOW and
+ * the robot made it less than STALL_DISTANCE, it's stalled.
+ *
+ * recoverFromStall() is what to do about it - Back off, turn a little so it comes at whatever it caught on from a different
+ * angle, and let the caller pick back up where it was. How far, how much, and how many times before it gives up on the
+ * move are all in stallRecovery. Every stall gets logged with where it happened, so the spots it keeps happening at can get
+ * fixed for real.
+ *
+ * goToPoint, followPosePath and climbRamp (ramp.h) recover. pushUntilContact (push.h) runs into things on purpose, so for
+ * it a stall just means it's up against whatever it was pushing.
+ */
+
+#define STALL_WINDOW .3             // Seconds of being told to drive before it can call a stall
+#define STALL_DISTANCE .2           // Inches it has to make it over a window to not be stalled
+#define STALL_MIN_POWER .1          // Forward power (either way) below which it isn't really being told to go anywhere
+#define STALL_MAX_SAMPLES 64        // Most ticks a window can be - Plenty at the control loop tick (.01 s and up)
+
+// How recoverFromStall() gets unstuck
+struct StallRecovery
+{
+    float backOffPower;             // Fraction of full power it backs away at
+    float backOffInches;            // How far it backs away
+    float backOffSeconds;           // How long backing away should take (see moveByOdometry in odometry.h)
+    float offsetDegrees;            // How far it turns before going again - Alternates sides each stall
+    int maxRetries;                 // Stalls it gets unstuck from in one move before giving up on the move
+};
+
+ROBOT_STATE StallRecovery stallRecovery = { .4, 1.5, .6, 10, 3 };
+
+class ProgressMonitor
+{
+public:
+    /**
+     * @param tickPeriod is how often the loop it's watching runs (see scheduler.h). The window gets counted in ticks, so
+     * watching progress doesn't take any clock reads of its own - If a tick runs long, the window just ends up a little longer.
+     */
+    ProgressMonitor(const char *monitorName, float tickPeriod) : name(monitorName), stalls(0), count(0), next(0)
+    {
+        windowTicks = (int)ceil(STALL_WINDOW / tickPeriod);
+        if (windowTicks >= STALL_MAX_SAMPLES)
+            windowTicks = STALL_MAX_SAMPLES - 1;
+        if (windowTicks < 1)
+            windowTicks = 1;
+    }
+
+    /**
+     * @brief IsStalled adds where the robot is now to the window and says whether it's stalled. Call it once a tick while
+     * the move is running. Readings without RPS (negative) get skipped.
+     */
+    bool IsStalled(float x, float y)
+    {
+        // Only counts while it's being told to drive - A turn in place or a wait in between starts it over
+        if (fabs((drive.Left() + drive.Right()) / 2) < STALL_MIN_POWER)
+        {
+            Restart();
+            return false;
+        }
+        if (x < 0 || y < 0)
+            return false;
+
+        ProgressSample &sample = samples[next];
+        sample.x = x;
+        sample.y = y;
+        next = (next + 1) % STALL_MAX_SAMPLES;
+        if (count < STALL_MAX_SAMPLES)
+            count++;
+
+        // Hasn't been driving a whole window yet, so it can't tell
+        if (count <= windowTicks)
+            return false;
+        const ProgressSample &old = samples[(next - 1 - windowTicks + STALL_MAX_SAMPLES) % STALL_MAX_SAMPLES];
+        return getDistance(old.x, old.y, x, y) < STALL_DISTANCE;
+    }
+
+    // Forgets the window (but not how many stalls there have been)
+    void Restart() { count = 0; }
+
+    const char *Name() const { return name; }
+    int Stalls() const { return stalls; }
+    void AddStall() { stalls++; }
+
+private:
+    struct ProgressSample
+    {
+        float x, y;
+    };
+
+    const char *name;
+    int stalls;
+    int windowTicks;
+    ProgressSample samples[STALL_MAX_SAMPLES];
+    int count, next;
+};
+
+/**
+ * @brief recoverFromStall logs a stall and gets the robot unstuck (see the top of this file).
+ * @param direction is which way the move was driving - 1 for forwards, -1 for backwards.
+ * @return Whether the move should keep going - False once it's used up stallRecovery.maxRetries.
+ */
+bool recoverFromStall(ProgressMonitor &progress, int direction)
+{
+    drive.Stop();
+    progress.AddStall();
+    SD.Printf("Stall: %s stalled at (%f, %f) facing %f going %s - Stall %d.\r\n", progress.Name(), robot.lastValid.x,
+              robot.lastValid.y, robot.lastValid.heading, direction > 0 ? "forwards" : "backwards", progress.Stalls());
+
+    if (progress.Stalls() > stallRecovery.maxRetries)
+    {
+        SD.Printf("Stall: Giving up on this %s after %d stalls.\r\n", progress.Name(), progress.Stalls());
+        return false;
+    }
+
+    driveDistance(-direction * stallRecovery.backOffPower, stallRecovery.backOffInches, stallRecovery.backOffSeconds);
+
+    // Odd stalls go left, even ones right
+    float turnSpeed = progress.Stalls() % 2 == 1 ? .4 : -.4;
+    turnDegrees(turnSpeed, stallRecovery.offsetDegrees, stallRecovery.offsetDegrees * SECONDS_PER_DEGREE);
+
+    progress.Restart();
+    return true;
+}
+
+#endif // STALL_H
@@ -0,0 +1,107 @@
+#ifndef STARTLIGHT_H
+#define STARTLIGHT_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// Custom Libraries
+#include "constants.h"
+#include "deadline.h"
+#include "scheduler.h"
+
+/*
+ * Start light detection. The CdS cell reads lower the more light it sees, and what it reads with the light off depends on
+ * the room and exactly where the robot got set down, so on top of a fixed threshold this learns what "off" looks like
+ * while it waits, then goes as soon as the reading drops well below that.
+ *
+ * The learned baseline starts at the first reading, so if the light's already on when the wait starts (the robot got set
+ * down late), the baseline is the lit reading and nothing ever drops below it. The fixed START_LIGHT_LIT_THRESHOLD (what
+ * the old fixed-threshold loop used) still catches that.
+ *
+ * It samples fast (every START_LIGHT_SAMPLE_PERIOD) and only needs START_LIGHT_DEBOUNCE_SAMPLES dark-to-light samples in a
+ * row, so it reacts within a few hundredths of a second. Nothing gets drawn per sample - the screen updates in the
+ * background - and recording is paused while it waits, since every sample reads the light sensor and the clock and each of
+ * those would otherwise be an SD line (see recording.h). The SD log gets one line at the end with how long the reaction took.
+ *
+ * That leaves no samples for a replay to feed back in, so replays skip the wait entirely. Both sides then restart the
+ * background tasks from the time it went, so they still run at the same times as each other afterwards.
+ */
+
+#define START_LIGHT_SAMPLE_PERIOD .005      // Seconds between samples
+#define START_LIGHT_DEBOUNCE_SAMPLES 3      // Samples in a row that have to look lit before we go
+#define START_LIGHT_DROP_FRACTION .5        // Lit means reading below this fraction of the baseline...
+#define START_LIGHT_MINIMUM_DROP .3         // ...and at least this far below it (volts), so noise on a dark baseline can't trigger it
+#define START_LIGHT_BASELINE_WEIGHT .02     // How much each unlit sample moves the baseline
+#define START_LIGHT_LIT_THRESHOLD .75       // Anything reading below this (volts) is lit, no matter the baseline
+#define START_LIGHT_TIMEOUT 30              // Seconds to wait before going anyways
+
+/**
+ * @brief waitForStartLight samples the light sensor until the start light comes on (or START_LIGHT_TIMEOUT runs out).
+ */
+void waitForStartLight()
+{
+    Deadline deadline(START_LIGHT_TIMEOUT);
+    double firstLitTime = 0;
+    float baseline = robot.hardware.lightSensor.Value();
+    int litSamples = 0;
+
+    startTicks(START_LIGHT_TICK, START_LIGHT_SAMPLE_PERIOD);
+    while (true)
+    {
+        float value = robot.hardware.lightSensor.Value();
+        double now = timeNow();
+
+        float drop = baseline - value;
+        bool isDroppedFromBaseline = value < baseline * START_LIGHT_DROP_FRACTION && drop > START_LIGHT_MINIMUM_DROP;
+        if (isDroppedFromBaseline || value < START_LIGHT_LIT_THRESHOLD)
+        {
+            if (litSamples == 0)
+                firstLitTime = now;
+            litSamples++;
+
+            if (litSamples >= START_LIGHT_DEBOUNCE_SAMPLES)
+            {
+                SD.Printf("Start light: Baseline %f, lit reading %f\r\n", baseline, value);
+                SD.Printf("Start light: First lit sample at %f, went at %f (reaction time %f s, plus up to %f s between samples)\r\n",
+                          firstLitTime, now, now - firstLitTime, START_LIGHT_SAMPLE_PERIOD);
+                return;
+            }
+        }
+        else
+        {
+            // Only dark samples count towards the baseline, so a flicker of light doesn't drag it down
+            litSamples = 0;
+            baseline += (value - baseline) * START_LIGHT_BASELINE_WEIGHT;
+        }
+
+        if (deadline.HasPassed())
+        {
+            SD.Printf("Start light: Never saw it (baseline %f) - Going anyways after %d seconds\r\n", baseline, START_LIGHT_TIMEOUT);
+            return;
+        }
+
+        waitForTick(START_LIGHT_TICK);
+    }
+}
+
+/**
+ * @brief loopWhileStartLightIsOff blocks until the start light comes on (or START_LIGHT_TIMEOUT runs out), without recording
+ * any of the samples.
+ */
+void loopWhileStartLightIsOff()
+{
+    setStatusMessage("Waiting for start light.");
+    SD.Printf("Waiting for start light.\r\n");
+
+    if (!isReplaying)
+    {
+        bool wasRecording = isRecording;
+        isRecording = false;
+        waitForStartLight();
+        isRecording = wasRecording;
+    }
+
+    restartBackgroundTasks(timeNow());
+}
+
+#endif // STARTLIGHT_H
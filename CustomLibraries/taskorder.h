@@ -0,0 +1,242 @@
+#ifndef TASKORDER_H
+#define TASKORDER_H
+
+// FEH Libraries
+#include <FEHSD.h>
+
+// Custom Libraries
+#include "budget.h"
+#include "constants.h"
+#include "course.h"
+#include "route.h"
+#include "utility.h"
+
+/*
+ * Task order planner. Where the stations end up after calibrate() (and which DDR button we end up on) changes which order
+ * of tasks is quickest, so instead of always going token -> DDR -> RPS button -> ramp -> foosball -> lever -> end button,
+ * planTaskOrder() works out the fastest order and finalRoutine runs the tasks in that order.
+ *
+ * Each task is the points its segment drives through (see the segments in main.cpp) plus however long it spends actually
+ * doing the task. Drive time between two points is a simple model - turn to face it, then drive straight there - so the
+ * travel time from the end of every task to the start of every other one makes a small matrix, and the best order through
+ * it gets found exactly (dynamic programming over which tasks are done, 2^7 * 7 states).
+ *
+ * Orders have to respect:
+ *  - Everything on the lower level before the ramp, and everything on the upper level after it
+ *  - The RPS button right before the ramp - The upper level has no RPS until it's pressed, and only for a while after
+ *  - The end button last
+ * The DDR light gets read as part of the DDR task, right before the button press that depends on it, so it never has to
+ * be planned around on its own.
+ *
+ * A drive between two tasks that the hand-tuned order doesn't already make has to be clear of everything on the course
+ * map (course.h), otherwise that pair just can't go back to back. The hand-tuned order is always allowed, so there's
+ * always an answer.
+ *
+ * finalRoutine plans over again after every task, from wherever the robot actually is, so the DDR color (which decides
+ * where that task ends) gets taken into account for the rest of the run.
+ */
+
+#define PLANNER_DRIVE_INCHES_PER_SECOND 9.5    // Average goToPoint speed, start to stop
+#define PLANNER_TURN_DEGREES_PER_SECOND 150    // Average turn() speed, including settling
+#define PLANNER_LEG_SECONDS .6                 // Extra time every goToPoint call takes (getting RPS, speeding up, stopping)
+#define PLANNER_CLEARANCE (ROBOT_RADIUS + .25) // How far a new drive between tasks has to stay from everything
+#define PLANNER_MAX_POINTS 4
+
+/**
+ * @brief TaskStop is the part of a task the planner cares about - Where it drives through and how long it sits still.
+ * The first point is where the task starts (where it's driven to from the last task) and the last is where it ends.
+ */
+struct TaskStop
+{
+    float points[PLANNER_MAX_POINTS][2];
+    int pointCount;
+    float endHeading;       // Which way the robot faces when the task's done (-1 if it depends)
+    float workSeconds;      // Time spent on the task itself - Precise turns, arm moves, holds
+    int mustFollow;         // Tasks (bit per task) that have to be done before this one can start
+};
+
+ROBOT_STATE TaskStop taskStops[TASK_COUNT];
+
+// The order finalRoutine runs tasks in - Starts out as the hand-tuned one
+ROBOT_STATE int taskOrder[TASK_COUNT] = { TASK_TOKEN, TASK_DDR, TASK_RPS_BUTTON, TASK_RAMP, TASK_FOOSBALL, TASK_LEVER, TASK_END_BUTTON };
+
+// Sets up one task's stop
+void setTaskStop(int task, float workSeconds, float endHeading, int mustFollow, int pointCount, const float points[][2])
+{
+    TaskStop &stop = taskStops[task];
+    stop.workSeconds = workSeconds;
+    stop.endHeading = endHeading;
+    stop.mustFollow = mustFollow;
+    stop.pointCount = pointCount;
+    for (int i = 0; i < pointCount; i++)
+    {
+        stop.points[i][0] = points[i][0];
+        stop.points[i][1] = points[i][1];
+    }
+}
+
+/**
+ * @brief fillTaskStops works out where every task is from the calibrated stations and the route. Has to come after calibrate().
+ */
+void fillTaskStops()
+{
+    const int LOWER_LEVEL = (1 << TASK_TOKEN) | (1 << TASK_DDR) | (1 << TASK_RPS_BUTTON);
+    const int ALL_BUT_END = (1 << TASK_END_BUTTON) - 1;
+
+    const float token[][2] = { { robot.calibration.tokenX, robot.calibration.tokenY } };
+    setTaskStop(TASK_TOKEN, 3.5, robot.calibration.tokenHeading, 0, 1, token);
+
+    float nearLightX = robot.calibration.ddrBlueLightX - 4.25, stagingX = robot.calibration.ddrBlueLightX - 2;
+    const float ddr[][2] = { { nearLightX, robot.calibration.ddrLightY }, { stagingX, robot.calibration.ddrLightY + route.ddrStagingY } };
+    setTaskStop(TASK_DDR, 25, -1, 0, 2, ddr);
+
+    const float rpsButton[][2] = { { robot.calibration.rpsButtonX, robot.calibration.rpsButtonY } };
+    setTaskStop(TASK_RPS_BUTTON, 5.5, robot.calibration.rpsButtonHeading, (1 << TASK_TOKEN) | (1 << TASK_DDR), 1, rpsButton);
+
+    const float ramp[][2] = { { robot.calibration.ddrBlueLightX + route.rampBottomX, robot.calibration.ddrLightY + route.rampBottomY },
+                              { robot.calibration.ddrBlueLightX + route.rampTopX, route.rampTopY } };
+    setTaskStop(TASK_RAMP, 0, NORTH, LOWER_LEVEL, 2, ramp);
+
+    float foosballY = robot.calibration.foosballStartY - .25;
+    const float foosball[][2] = { { robot.calibration.foosballStartX, foosballY }, { (robot.calibration.foosballStartX + robot.calibration.foosballEndX) / 2, robot.calibration.foosballStartY } };
+    setTaskStop(TASK_FOOSBALL, 6, EAST, LOWER_LEVEL | (1 << TASK_RAMP), 2, foosball);
+
+    const float lever[][2] = { { robot.calibration.leverX + route.leverApproachX, robot.calibration.leverY + route.leverApproachY }, { robot.calibration.leverX, robot.calibration.leverY } };
+    setTaskStop(TASK_LEVER, 3, robot.calibration.leverHeading, LOWER_LEVEL | (1 << TASK_RAMP), 2, lever);
+
+    const float endButton[][2] = { { 5.5, 5.0 } };
+    setTaskStop(TASK_END_BUTTON, 0, SOUTH, ALL_BUT_END, 1, endButton);
+}
+
+/**
+ * @brief driveSeconds is the drive-time model - Turn from startHeading to face the point, then drive straight to it.
+ * @param startHeading can be -1 if it's not known, in which case the turn's left out.
+ */
+float driveSeconds(float startX, float startY, float startHeading, float endX, float endY)
+{
+    float seconds = PLANNER_LEG_SECONDS + getDistance(startX, startY, endX, endY) / PLANNER_DRIVE_INCHES_PER_SECOND;
+    if (startHeading >= 0)
+        seconds += smallestDistanceBetweenHeadings(startHeading, getDesiredHeading(startX, startY, endX, endY)) / PLANNER_TURN_DEGREES_PER_SECOND;
+    return seconds;
+}
+
+// Seconds a task takes once the robot's at its first point - Driving between its own points, plus the task itself
+float taskSeconds(int task)
+{
+    const TaskStop &stop = taskStops[task];
+    float seconds = stop.workSeconds;
+    for (int i = 1; i < stop.pointCount; i++)
+        seconds += driveSeconds(stop.points[i - 1][0], stop.points[i - 1][1], -1, stop.points[i][0], stop.points[i][1]);
+    return seconds;
+}
+
+// Whether the hand-tuned order goes straight from one task to the other (those drives are known to work)
+bool isHandTunedPair(int from, int to) { return to == from + 1; }
+
+/**
+ * @brief travelSeconds is one entry of the travel-time matrix - From the end of one task to the start of another.
+ * @return -1 if the drive between them isn't clear.
+ */
+float travelSeconds(int from, int to)
+{
+    const TaskStop &fromStop = taskStops[from], &toStop = taskStops[to];
+    float fromX = fromStop.points[fromStop.pointCount - 1][0], fromY = fromStop.points[fromStop.pointCount - 1][1];
+    float toX = toStop.points[0][0], toY = toStop.points[0][1];
+
+    if (!isHandTunedPair(from, to) && !courseSegmentIsClear(fromX, fromY, toX, toY, PLANNER_CLEARANCE))
+        return -1;
+    return driveSeconds(fromX, fromY, fromStop.endHeading, toX, toY);
+}
+
+/**
+ * @brief planTaskOrder finds the quickest order for every task that isn't done yet, starting from where the robot is now,
+ * and writes it into taskOrder (done tasks stay at the front, in the order they happened).
+ * @param doneCount is how many of the tasks at the front of taskOrder are already done.
+ * @return Predicted seconds for the rest of the run, or -1 if there's no order that works (taskOrder is left alone).
+ */
+float planTaskOrder(int doneCount, float x, float y, float heading)
+{
+    const int STATES = 1 << TASK_COUNT;
+    const float NONE = -1;
+
+    int doneTasks = 0;
+    for (int i = 0; i < doneCount; i++)
+        doneTasks |= 1 << taskOrder[i];
+
+    // Travel-time matrix, and how long each task takes on its own
+    float travel[TASK_COUNT][TASK_COUNT], seconds[TASK_COUNT];
+    for (int from = 0; from < TASK_COUNT; from++)
+    {
+        seconds[from] = taskSeconds(from);
+        for (int to = 0; to < TASK_COUNT; to++)
+            travel[from][to] = from == to ? NONE : travelSeconds(from, to);
+    }
+
+    // best[done][last] = Quickest time to have done exactly the tasks in "done", ending on "last" (static to keep it off the stack)
+    static ROBOT_STATE float best[STATES][TASK_COUNT];
+    static ROBOT_STATE int previous[STATES][TASK_COUNT];
+    for (int done = 0; done < STATES; done++)
+        for (int last = 0; last < TASK_COUNT; last++)
+            best[done][last] = NONE;
+
+    // First task - Straight from where the robot is now. The drive from here was never checked against the map, so it's trusted.
+    for (int task = 0; task < TASK_COUNT; task++)
+    {
+        if (doneTasks & (1 << task) || (taskStops[task].mustFollow & ~doneTasks))
+            continue;
+        best[doneTasks | (1 << task)][task] = driveSeconds(x, y, heading, taskStops[task].points[0][0], taskStops[task].points[0][1]) + seconds[task];
+        previous[doneTasks | (1 << task)][task] = -1;
+    }
+
+    for (int done = 0; done < STATES; done++)
+    {
+        if ((done & doneTasks) != doneTasks)
+            continue;
+
+        for (int last = 0; last < TASK_COUNT; last++)
+        {
+            if (best[done][last] == NONE)
+                continue;
+
+            for (int next = 0; next < TASK_COUNT; next++)
+            {
+                if (done & (1 << next) || (taskStops[next].mustFollow & ~done) || travel[last][next] == NONE)
+                    continue;
+
+                float total = best[done][last] + travel[last][next] + seconds[next];
+                int after = done | (1 << next);
+                if (best[after][next] == NONE || total < best[after][next])
+                {
+                    best[after][next] = total;
+                    previous[after][next] = last;
+                }
+            }
+        }
+    }
+
+    // Everything done, ending on the end button (it has to follow everything else, so that's the only way to finish)
+    int done = STATES - 1, last = TASK_END_BUTTON;
+    float total = best[done][last];
+    if (total == NONE)
+    {
+        SD.Printf("Task order: No order works from (%f, %f) - Sticking with the last one.\r\n", x, y);
+        return -1;
+    }
+
+    // Walks back through the choices to get the order
+    for (int i = TASK_COUNT - 1; i >= doneCount; i--)
+    {
+        taskOrder[i] = last;
+        int before = previous[done][last];
+        done &= ~(1 << last);
+        last = before;
+    }
+
+    SD.Printf("Task order: Predicting %f s for the rest -", total);
+    for (int i = doneCount; i < TASK_COUNT; i++)
+        SD.Printf(" %s", taskBudgets[taskOrder[i]].name);
+    SD.Printf("\r\n");
+    return total;
+}
+
+#endif // TASKORDER_H
@@ -12,10 +12,10 @@ void rpsSquare()
 {
     while (true)
     {
-        goToPoint(10, 16, false, 0.0, false, 0.0, false, false);
-        goToPoint(16, 16, false, 0.0, false, 0.0, false, false);
-        goToPoint(16, 10, false, 0.0, false, 0.0, false, false);
-        goToPoint(10, 10, false, 0, false, 0.0, false, false);
+        goToPoint<Forwards, Untimed, SlowSpeed>(10, 16);
+        goToPoint<Forwards, Untimed, SlowSpeed>(16, 16);
+        goToPoint<Forwards, Untimed, SlowSpeed>(16, 10);
+        goToPoint<Forwards, Untimed, SlowSpeed>(10, 10);
     }
 }
 
@@ -26,9 +26,9 @@ void rpsTest()
 {
     while (true)
     {
-        LCD.WriteLine(RPS.X());
-        LCD.WriteLine(RPS.Y());
-        LCD.WriteLine(RPS.Heading());
+        LCD.WriteLine(rpsX());
+        LCD.WriteLine(rpsY());
+        LCD.WriteLine(rpsHeading());
 
         Sleep(.1);
         clearLCD();
@@ -3,6 +3,8 @@
 
 #include "conversions.h"
 #include "constants.h"
+#include "scheduler.h"
+#include "arm.h"
 
 using namespace std;
 
@@ -44,18 +46,16 @@ float smallestDistanceBetweenHeadings(float startHeading, float endHeading)
     return ccwDistance;
 }
 
+/**
+ * @brief gradualServoTurn eases the arm down to a degree (a degree every hundredth of a second), holds it there for half a second, then puts it back up.
+ */
 void gradualServoTurn(float endDegree)
 {
-    float currentDegree = 30;
-    while (currentDegree <= endDegree)
-    {
-        armServo.SetDegree(currentDegree);
-        currentDegree++;
-        Sleep(.01);
-    }
-    Sleep(.5);
-    armServo.SetDegree(30);
-    Sleep(.5);
+    robot.hardware.armServo.SetDegree(30);
+    moveArm(endDegree, 100, .5);
+    waitForArm();
+    moveArm(30);
+    waitForArm();
 }
 
 /**
@@ -106,13 +106,12 @@ bool shouldTurnLeft(float startHeading, float endHeading)
 
 void loopUntilTouch()
 {
-    float x, y;
-    while (!LCD.Touch(&x, &y))
+    float x = 0, y = 0;
+    while (!lcdTouch(&x, &y))
     {
         SD.Printf("Waiting for screen touch to progress in the program\r\n");
-        clearLCD();
-        LCD.WriteLine("Waiting for Screen Touch.");
-        Sleep(.1);
+        setStatusMessage("Waiting for Screen Touch.");
+        schedulerSleep(.1);
     }
 }
 
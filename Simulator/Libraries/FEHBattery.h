@@ -0,0 +1,15 @@
+#ifndef FEHBATTERY_H
+#define FEHBATTERY_H
+
+// Host stand-in for the Proteus FEHBattery library
+#include "FEHUtility.h"
+
+class FEHBattery
+{
+public:
+    float Voltage() { return hostBackend->batteryVoltage(); }
+};
+
+FEHBattery Battery;
+
+#endif // FEHBATTERY_H
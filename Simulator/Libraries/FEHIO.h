@@ -0,0 +1,54 @@
+#ifndef FEHIO_H
+#define FEHIO_H
+
+// Host stand-in for the Proteus FEHIO library
+#include "FEHUtility.h"
+
+class FEHIO
+{
+public:
+    typedef enum
+    {
+        P0_0 = 0, P0_1, P0_2, P0_3, P0_4, P0_5, P0_6, P0_7,
+        P1_0, P1_1, P1_2, P1_3, P1_4, P1_5, P1_6, P1_7,
+        P2_0, P2_1, P2_2, P2_3, P2_4, P2_5, P2_6, P2_7,
+        P3_0, P3_1, P3_2, P3_3, P3_4, P3_5, P3_6, P3_7,
+        BATTERY_VOLTAGE
+    } FEHIOPin;
+
+    typedef enum { RisingEdge = 0, FallingEdge, EitherEdge } FEHIOInterruptTrigger;
+};
+
+class AnalogInputPin
+{
+public:
+    AnalogInputPin(FEHIO::FEHIOPin p) : pin(p) {}
+    float Value() { return hostBackend->analogValue(pin); }
+
+private:
+    FEHIO::FEHIOPin pin;
+};
+
+class DigitalInputPin
+{
+public:
+    DigitalInputPin(FEHIO::FEHIOPin p) : pin(p) {}
+    bool Value() { return hostBackend->digitalValue(pin); }
+
+private:
+    FEHIO::FEHIOPin pin;
+};
+
+class DigitalEncoder
+{
+public:
+    DigitalEncoder(FEHIO::FEHIOPin p, FEHIO::FEHIOInterruptTrigger trigger) : pin(p) {}
+    DigitalEncoder(FEHIO::FEHIOPin p) : pin(p) {}
+    int Counts() { return hostBackend->encoderCounts(pin); }
+    void ResetCounts() { hostBackend->resetEncoderCounts(pin); }
+
+private:
+    FEHIO::FEHIOPin pin;
+};
+
+#endif // FEHIO_H
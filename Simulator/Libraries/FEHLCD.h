@@ -0,0 +1,41 @@
+#ifndef FEHLCD_H
+#define FEHLCD_H
+
+// Host stand-in for the Proteus FEHLCD library - Nothing is drawn, but every call reports roughly how long the real one takes
+#include "FEHUtility.h"
+
+// Rough costs of the real calls, in seconds (a full clear repaints all 320x240 pixels over SPI)
+#define LCD_CLEAR_COST .012
+#define LCD_WRITE_COST .0015
+#define LCD_FILL_COST .002
+
+class FEHLCD
+{
+public:
+    typedef enum { Black = 0, White, Red, Green, Blue, Scarlet, Gray } FEHLCDColor;
+
+    void Clear(FEHLCDColor color) { hostBackend->lcdCall(LCD_CLEAR_COST); }
+    void Clear() { hostBackend->lcdCall(LCD_CLEAR_COST); }
+    void SetFontColor(unsigned int color) {}
+    void SetBackgroundColor(unsigned int color) {}
+
+    void Write(const char *text) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void Write(int value) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void Write(float value) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void Write(double value) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void WriteLine(const char *text) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void WriteLine(int value) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void WriteLine(float value) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void WriteLine(double value) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void WriteAt(const char *text, int x, int y) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void WriteAt(int value, int x, int y) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void WriteAt(float value, int x, int y) { hostBackend->lcdCall(LCD_WRITE_COST); }
+    void FillRectangle(int x, int y, int width, int height) { hostBackend->lcdCall(LCD_FILL_COST); }
+    void DrawRectangle(int x, int y, int width, int height) { hostBackend->lcdCall(LCD_FILL_COST); }
+
+    bool Touch(float *x, float *y) { return hostBackend->touch(x, y); }
+};
+
+FEHLCD LCD;
+
+#endif // FEHLCD_H
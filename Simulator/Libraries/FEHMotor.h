@@ -0,0 +1,21 @@
+#ifndef FEHMOTOR_H
+#define FEHMOTOR_H
+
+// Host stand-in for the Proteus FEHMotor library
+#include "FEHUtility.h"
+
+class FEHMotor
+{
+public:
+    typedef enum { Motor0 = 0, Motor1, Motor2, Motor3 } FEHMotorPort;
+
+    FEHMotor(FEHMotorPort motorport, float max_voltage) : port(motorport) {}
+
+    void SetPercent(float percent) { hostBackend->setMotorPercent(port, percent); }
+    void Stop() { hostBackend->setMotorPercent(port, 0); }
+
+private:
+    FEHMotorPort port;
+};
+
+#endif // FEHMOTOR_H
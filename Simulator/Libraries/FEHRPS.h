@@ -0,0 +1,18 @@
+#ifndef FEHRPS_H
+#define FEHRPS_H
+
+// Host stand-in for the Proteus FEHRPS library
+#include "FEHUtility.h"
+
+class FEHRPS
+{
+public:
+    void InitializeTouchMenu() {}
+    float X() { return hostBackend->rpsX(); }
+    float Y() { return hostBackend->rpsY(); }
+    float Heading() { return hostBackend->rpsHeading(); }
+};
+
+FEHRPS RPS;
+
+#endif // FEHRPS_H
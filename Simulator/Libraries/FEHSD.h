@@ -0,0 +1,53 @@
+#ifndef FEHSD_H
+#define FEHSD_H
+
+// Host stand-in for the Proteus FEHSD library - The log goes to the backend, files go to the host's working directory
+#include <cstdio>
+#include <cstdarg>
+#include "FEHUtility.h"
+
+typedef FILE FEHFile;
+
+class FEHSD
+{
+public:
+    int OpenLog() { return 0; }
+    void CloseLog() {}
+
+    int Printf(const char *format, ...)
+    {
+        char line[512];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        hostBackend->sdLine(line);
+        return length;
+    }
+
+    FEHFile *FOpen(const char *path, const char *mode) { return fopen(path, mode); }
+    int FClose(FEHFile *file) { return fclose(file); }
+    int FEof(FEHFile *file) { return feof(file); }
+
+    int FPrintf(FEHFile *file, const char *format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        int length = vfprintf(file, format, args);
+        va_end(args);
+        return length;
+    }
+
+    int FScanf(FEHFile *file, const char *format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        int count = vfscanf(file, format, args);
+        va_end(args);
+        return count;
+    }
+};
+
+FEHSD SD;
+
+#endif // FEHSD_H
@@ -0,0 +1,24 @@
+#ifndef FEHSERVO_H
+#define FEHSERVO_H
+
+// Host stand-in for the Proteus FEHServo library
+#include "FEHUtility.h"
+
+class FEHServo
+{
+public:
+    typedef enum { Servo0 = 0, Servo1, Servo2, Servo3, Servo4, Servo5, Servo6, Servo7 } FEHServoPort;
+
+    FEHServo(FEHServoPort servoport) : port(servoport) {}
+
+    void SetDegree(float degree) { hostBackend->setServoDegree(port, degree); }
+    void SetMin(int min) {}
+    void SetMax(int max) {}
+    void TouchCalibrate() {}
+    void Off() {}
+
+private:
+    FEHServoPort port;
+};
+
+#endif // FEHSERVO_H
@@ -0,0 +1,15 @@
+#ifndef FEHUTILITY_H
+#define FEHUTILITY_H
+
+// Host stand-in for the Proteus FEHUtility library - Time only moves when the backend says it does
+#include "../backend.h"
+
+void Sleep(int msec) { hostBackend->sleep(msec / 1000.0); }
+void Sleep(float sec) { hostBackend->sleep(sec); }
+void Sleep(double sec) { hostBackend->sleep(sec); }
+
+double TimeNow() { return hostBackend->now(); }
+unsigned int TimeNowSec() { return (unsigned int) hostBackend->now(); }
+unsigned long TimeNowMSec() { return (unsigned long) (hostBackend->now() * 1000); }
+
+#endif // FEHUTILITY_H
@@ -0,0 +1,52 @@
+#ifndef SIMULATOR_BACKEND_H
+#define SIMULATOR_BACKEND_H
+
+/*
+ * The FEH library stand-ins in Simulator/Libraries don't do anything on their own - Every call gets forwarded to whatever
+ * HostBackend is currently plugged in. The replay tool plugs in a backend that serves recorded inputs, the simulation
+ * tools plug in one that runs a physics model of the robot on the course. The robot code itself can't tell the difference.
+ */
+
+class HostBackend
+{
+public:
+    virtual ~HostBackend() {}
+
+    // Time
+    virtual double now() = 0;
+    virtual void sleep(double seconds) = 0;
+
+    // RPS
+    virtual float rpsX() = 0;
+    virtual float rpsY() = 0;
+    virtual float rpsHeading() = 0;
+
+    // Inputs (pin is the FEHIO pin number)
+    virtual float analogValue(int pin) = 0;
+    virtual bool digitalValue(int pin) = 0;
+    virtual int encoderCounts(int pin) { return 0; }
+    virtual void resetEncoderCounts(int pin) {}
+    virtual bool touch(float *x, float *y) = 0;
+    virtual float batteryVoltage() { return 11.7; }
+
+    // Outputs (port is the FEHMotor/FEHServo port number)
+    virtual void setMotorPercent(int port, float percent) = 0;
+    virtual void setServoDegree(int port, float degree) = 0;
+
+    // Logging & screen - cost is roughly how long the real call blocks the Proteus for, in seconds
+    virtual void sdLine(const char *text) {}
+    virtual void lcdCall(double cost) {}
+};
+
+// Every simulation thread runs its own robot (see simulation.h), so every robot global marked ROBOT_STATE is per thread, and
+// so is the backend it's plugged into. thread_local needs C++11 - Anything older only ever runs the one robot anyway.
+#if __cplusplus >= 201103L
+#define ROBOT_STATE thread_local
+#else
+#define ROBOT_STATE
+#endif
+
+// Whatever backend the current thread has plugged in
+ROBOT_STATE HostBackend *hostBackend = 0;
+
+#endif // SIMULATOR_BACKEND_H
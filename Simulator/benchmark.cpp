@@ -0,0 +1,240 @@
+/*
+ * benchmark.cpp - Times each piece of finalRoutine in the simulator and checks that none of them got slower.
+ *
+ * finalRoutine is split into segments (tokenSegment(), ddrSegment(), ... in main.cpp). Each one gets run on its own from
+ * a fixed starting spot, on the same simulated courses (seeds) every time, so a change to one segment only shows up in that
+ * segment's numbers. For each segment it records:
+ *  - Simulated time, start to finish
+ *  - Control iterations (passes through the goToPoint/turn loops)
+ *  - Final error - How far off the task the robot was when the arm went down, or for segments without a task, how far
+ *    off the segment's last point it ended up
+ *
+ * Those get compared against Simulator/benchmark_baseline.txt, which is committed with the code. If any segment's average
+ * time is more than the threshold slower than the baseline (or a segment never finishes), it exits with 1.
+ *
+ * Build (from the repository root):
+ *     g++ -std=c++11 -O2 -ISimulator/Libraries -ICustomLibraries Simulator/benchmark.cpp -o benchmark
+ *
+ * Run (from the repository root):
+ *     ./benchmark [--baseline Simulator/benchmark_baseline.txt] [--threshold .05]
+ *
+ * After a change that's meant to make things faster (or one that's slower on purpose), write a new baseline and commit it:
+ *     ./benchmark --write-baseline [--seeds 4]
+ *
+ * To check that replays still work, record a whole simulated run (boot to end button, with recording on) and play it back
+ * from an empty directory - Replay should say every command matches:
+ *     ./benchmark --log LOG.TXT [--seed 0]
+ *     ./replay LOG.TXT
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+
+#include "simulation.h"
+
+// One piece of finalRoutine and where the robot is when it starts (taken from a full simulated run, rounded)
+struct BenchSegment
+{
+    const char *name;
+    void (*run)();
+    float startX, startY, startHeading;
+    bool deadzoneUnlocked;
+};
+
+const BenchSegment SEGMENTS[] =
+{
+    { "token", tokenSegment, 8.5, 9.5, 60, false },
+    { "ddr", ddrSegment, 13.9, 20.5, 110, false },
+    { "rps_button", rpsButtonSegment, 27.2, 12, 277, false },
+    { "ramp", rampSegment, 20.6, 22.3, 134, true },
+    { "foosball", foosballSegment, 29.3, 56, 90, true },
+    { "lever", leverSegment, 24.9, 60.6, 5, true },
+    { "end_button", endButtonSegment, 8.5, 56.7, 33, true }
+};
+const int SEGMENT_COUNT = sizeof(SEGMENTS) / sizeof(SEGMENTS[0]);
+
+// Averages over every seed
+struct SegmentStats
+{
+    double time, iterations, error;
+    bool finished;
+};
+
+std::vector<SegmentStats> runSegments(int seedCount)
+{
+    std::vector<RunResult> runs = runInParallel(SEGMENT_COUNT * seedCount, [&](int index)
+    {
+        const BenchSegment &segment = SEGMENTS[index / seedCount];
+        return simulateSegment(segment.run, defaultScenario(index % seedCount), segment.startX, segment.startY,
+                               segment.startHeading, segment.deadzoneUnlocked);
+    });
+
+    std::vector<SegmentStats> stats(SEGMENT_COUNT);
+    for (int i = 0; i < SEGMENT_COUNT; i++)
+    {
+        SegmentStats &segment = stats[i];
+        segment.time = segment.iterations = segment.error = 0;
+        segment.finished = true;
+        for (int s = 0; s < seedCount; s++)
+        {
+            const RunResult &run = runs[i * seedCount + s];
+            segment.time += run.time / seedCount;
+            segment.iterations += run.controlIterations / seedCount;
+            segment.error += (run.tasksAttempted > 0 ? run.worstTaskError : run.finalError) / seedCount;
+            segment.finished = segment.finished && run.finished;
+        }
+    }
+    return stats;
+}
+
+bool readBaseline(const char *path, int &seedCount, std::vector<SegmentStats> &baseline)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    baseline.assign(SEGMENT_COUNT, SegmentStats());
+    std::vector<bool> found(SEGMENT_COUNT, false);
+    char text[256], name[64];
+    SegmentStats stats;
+    seedCount = 0;
+    while (fgets(text, sizeof(text), file))
+    {
+        if (sscanf(text, "seeds %d", &seedCount) == 1)
+            continue;
+        if (sscanf(text, "%63s %lf %lf %lf", name, &stats.time, &stats.iterations, &stats.error) != 4)
+            continue;
+
+        for (int i = 0; i < SEGMENT_COUNT; i++)
+            if (!strcmp(name, SEGMENTS[i].name))
+            {
+                stats.finished = true;
+                baseline[i] = stats;
+                found[i] = true;
+            }
+    }
+    fclose(file);
+
+    for (int i = 0; i < SEGMENT_COUNT; i++)
+        if (!found[i])
+        {
+            fprintf(stderr, "%s has no baseline for segment %s - Write a new one with --write-baseline\n", path, SEGMENTS[i].name);
+            return false;
+        }
+    return seedCount > 0;
+}
+
+bool writeBaseline(const char *path, int seedCount, const std::vector<SegmentStats> &stats)
+{
+    FILE *file = fopen(path, "w");
+    if (!file)
+        return false;
+
+    fprintf(file, "# Written by Simulator/benchmark.cpp --write-baseline - Averages over every seed\n");
+    fprintf(file, "seeds %d\n", seedCount);
+    fprintf(file, "# segment     time (s)  iterations  error (in)\n");
+    for (int i = 0; i < SEGMENT_COUNT; i++)
+        fprintf(file, "%-12s %9.3f %11.1f %11.3f\n", SEGMENTS[i].name, stats[i].time, stats[i].iterations, stats[i].error);
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *baselinePath = "Simulator/benchmark_baseline.txt";
+    float threshold = .05;
+    int seedCount = 4;
+    bool shouldWriteBaseline = false;
+    const char *logPath = 0;
+    int logSeed = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--write-baseline")) shouldWriteBaseline = true;
+        else if (!strcmp(argv[i], "--baseline") && i + 1 < argc) baselinePath = argv[++i];
+        else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) threshold = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--seeds") && i + 1 < argc) seedCount = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--log") && i + 1 < argc) logPath = argv[++i];
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) logSeed = atoi(argv[++i]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--baseline FILE] [--threshold FRACTION] [--write-baseline [--seeds N]] [--log FILE [--seed N]]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    if (logPath)
+    {
+        bool finished = false;
+        std::thread run([&]() { finished = recordSimulatedRun(defaultScenario(logSeed), logPath); });
+        run.join();
+        printf("Recorded a simulated run (seed %d) to %s%s\n", logSeed, logPath, finished ? "" : " - It didn't finish");
+        return finished ? 0 : 1;
+    }
+
+    if (shouldWriteBaseline)
+    {
+        std::vector<SegmentStats> stats = runSegments(seedCount);
+        for (int i = 0; i < SEGMENT_COUNT; i++)
+        {
+            printf("%-12s %7.2f s %7.1f iterations %6.2f in\n", SEGMENTS[i].name, stats[i].time, stats[i].iterations, stats[i].error);
+            if (!stats[i].finished)
+            {
+                fprintf(stderr, "%s didn't finish on every seed - Not writing a baseline\n", SEGMENTS[i].name);
+                return 1;
+            }
+        }
+
+        if (!writeBaseline(baselinePath, seedCount, stats))
+        {
+            fprintf(stderr, "Couldn't write %s\n", baselinePath);
+            return 2;
+        }
+        printf("Wrote %s\n", baselinePath);
+        return 0;
+    }
+
+    // Always uses the same seeds as the baseline, otherwise the averages aren't comparable
+    std::vector<SegmentStats> baseline;
+    if (!readBaseline(baselinePath, seedCount, baseline))
+    {
+        fprintf(stderr, "Couldn't read a baseline from %s (run from the repository root, or pass --baseline)\n", baselinePath);
+        return 2;
+    }
+
+    std::vector<SegmentStats> stats = runSegments(seedCount);
+
+    printf("%d seeds, failing on anything more than %.0f%% slower than %s\n\n", seedCount, threshold * 100, baselinePath);
+    printf("%-12s %9s %9s %8s   %10s %10s   %9s %9s\n", "segment", "baseline", "time", "change", "base iter", "iter", "base err", "err");
+
+    int regressions = 0;
+    for (int i = 0; i < SEGMENT_COUNT; i++)
+    {
+        const SegmentStats &before = baseline[i], &after = stats[i];
+        double change = (after.time - before.time) / before.time;
+
+        const char *verdict = "";
+        if (!after.finished)
+            verdict = "  DIDN'T FINISH";
+        else if (change > threshold)
+            verdict = "  SLOWER";
+        if (*verdict)
+            regressions++;
+
+        printf("%-12s %8.2fs %8.2fs %+7.1f%%   %10.1f %10.1f   %8.2fin %7.2fin%s\n", SEGMENTS[i].name, before.time, after.time,
+               change * 100, before.iterations, after.iterations, before.error, after.error, verdict);
+    }
+
+    if (regressions > 0)
+    {
+        printf("\n%d segment(s) regressed\n", regressions);
+        return 1;
+    }
+
+    printf("\nNo regressions\n");
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+ * replay.cpp - Re-runs a recorded competition run through the real robot code on a computer.
+ *
+ * The robot writes "REC" lines to its SD log for every input it reads and every motor/servo command it gives (see
+ * CustomLibraries/recording.h). This feeds those inputs back, in order, into the exact same main.cpp and CustomLibraries
+ * code, then checks that the code gives the same motor and servo commands it gave on the course. Since every input comes
+ * from the log, every decision goToPoint made on the course gets made again here, and can be stepped through in a debugger.
+ *
+ * It also prints how long each goToPoint/turn call took on the course, slowest first, which is where to start looking
+ * when a run is slow.
+ *
+ * Build (from the repository root):
+ *     g++ -std=c++11 -O2 -ISimulator/Libraries -ICustomLibraries Simulator/replay.cpp -o replay
+ *
+ * Run:
+ *     ./replay LOG.TXT
+ *
+ * Exits with 1 if the replayed commands don't match the recorded ones (i.e. the code no longer does what it did on the course).
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "backend.h"
+
+// Pulls in all of the robot code, with its main() renamed so this file can have its own
+#define main robotMain
+#include "../main.cpp"
+#undef main
+
+// One REC line
+struct Event
+{
+    double time;
+    float value;
+    double exactValue;      // Clock reads need every digit - value alone would round them
+    float touchX, touchY;
+};
+
+// Thrown when the robot code asks for an input the log doesn't have - That's where the replay ends
+struct ReplayFinished
+{
+    char type;
+};
+
+// One command that came out different from the recording
+struct Mismatch
+{
+    char type;
+    size_t index;
+    double time;
+    float recorded, replayed;
+    bool isExtra;
+};
+
+// One goToPoint/turn call, for the profile
+struct Call
+{
+    std::string name;
+    double start, end;
+    bool finished;
+};
+
+class ReplayBackend : public HostBackend
+{
+public:
+    std::map<char, std::deque<Event> > inputs;
+    std::map<char, std::vector<Event> > outputs;
+    std::map<char, size_t> outputsSeen;
+    std::vector<Mismatch> mismatches;
+    std::vector<Call> calls;
+    double clock;
+    double firstTime;
+
+    ReplayBackend() : clock(0), firstTime(-1) {}
+
+    bool load(const char *path)
+    {
+        FILE *file = fopen(path, "r");
+        if (!file)
+            return false;
+
+        char line[512];
+        while (fgets(line, sizeof(line), file))
+        {
+            if (strncmp(line, "REC ", 4) != 0)
+                continue;
+
+            char type;
+            Event event = Event();
+            if (sscanf(line, "REC %c %lf", &type, &event.time) != 2)
+                continue;
+
+            if (type == 'T')
+            {
+                int touched;
+                sscanf(line, "REC T %lf %d %f %f", &event.time, &touched, &event.touchX, &event.touchY);
+                event.value = touched;
+            }
+            else
+            {
+                sscanf(line, "REC %c %lf %lf", &type, &event.time, &event.exactValue);
+                event.value = (float) event.exactValue;
+            }
+
+            if (firstTime < 0)
+                firstTime = event.time;
+
+            if (type == 'L' || type == 'R' || type == 'S')
+                outputs[type].push_back(event);
+            else
+                inputs[type].push_back(event);
+        }
+
+        fclose(file);
+        return firstTime >= 0;
+    }
+
+    size_t inputsLeft()
+    {
+        size_t count = 0;
+        for (std::map<char, std::deque<Event> >::iterator it = inputs.begin(); it != inputs.end(); ++it)
+            count += it->second.size();
+        return count;
+    }
+
+    // Time
+    double now() { return next('C').exactValue; }
+    void sleep(double seconds) { clock += seconds; }
+
+    // Inputs - Every read takes the next recorded value of that type, and moves the clock to when it was read
+    float rpsX() { return next('X').value; }
+    float rpsY() { return next('Y').value; }
+    float rpsHeading() { return next('H').value; }
+    float analogValue(int pin) { return next('A').value; }
+    bool digitalValue(int pin) { return next('B').value != 0; }
+    float batteryVoltage() { return next('V').value; }
+    int encoderCounts(int pin) { return (int) next(pin == LEFT_ENCODER_PIN ? 'E' : 'F').value; }
+
+    bool touch(float *x, float *y)
+    {
+        Event event = next('T');
+        *x = event.touchX;
+        *y = event.touchY;
+        return event.value != 0;
+    }
+
+    // Outputs - Every command gets checked against the recorded one at the same position
+    void setMotorPercent(int port, float percent) { check(port == 0 ? 'L' : 'R', percent); }
+    void setServoDegree(int port, float degree) { check('S', degree); }
+
+    // Log lines - Only used for the profile
+    void sdLine(const char *text)
+    {
+        float a, b;
+        char name[64];
+
+        if (sscanf(text, "goToPoint: End (x, y): (%f, %f)", &a, &b) == 2)
+        {
+            closeOpenCall("goToPoint");
+            snprintf(name, sizeof(name), "goToPoint(%.2f, %.2f)", a, b);
+            openCall(name);
+        }
+        else if (strncmp(text, "goToPoint: FUNCTION SYNOPSIS", 28) == 0)
+            finishCall("goToPoint");
+        else if (sscanf(text, "turn: Entered function with currentHeading %f and endHeading %f", &a, &b) == 2)
+        {
+            closeOpenCall("turn");
+            snprintf(name, sizeof(name), "turn(%.1f)", b);
+            openCall(name);
+        }
+        else if (strncmp(text, "turn: FUNCTION SYNOPSIS", 23) == 0)
+            finishCall("turn");
+    }
+
+private:
+    Event next(char type)
+    {
+        std::deque<Event> &queue = inputs[type];
+        if (queue.empty())
+        {
+            ReplayFinished finished = { type };
+            throw finished;
+        }
+
+        Event event = queue.front();
+        queue.pop_front();
+        clock = event.time;
+        return event;
+    }
+
+    void check(char type, float value)
+    {
+        size_t index = outputsSeen[type]++;
+        std::vector<Event> &recorded = outputs[type];
+
+        if (index >= recorded.size())
+        {
+            Mismatch mismatch = { type, index, clock, 0, value, true };
+            mismatches.push_back(mismatch);
+        }
+        else if (fabs(recorded[index].value - value) > .01)
+        {
+            Mismatch mismatch = { type, index, recorded[index].time, recorded[index].value, value, false };
+            mismatches.push_back(mismatch);
+        }
+    }
+
+    void openCall(const char *name)
+    {
+        Call call = { name, clock, clock, false };
+        calls.push_back(call);
+    }
+
+    // Finds the most recent unfinished call whose name starts with prefix
+    Call *openCallNamed(const char *prefix)
+    {
+        for (int i = (int) calls.size() - 1; i >= 0; i--)
+            if (!calls[i].finished && calls[i].name.compare(0, strlen(prefix), prefix) == 0)
+                return &calls[i];
+        return 0;
+    }
+
+    void finishCall(const char *prefix)
+    {
+        Call *call = openCallNamed(prefix);
+        if (call)
+        {
+            call->end = clock;
+            call->finished = true;
+        }
+    }
+
+    // goToPoint and turn both have early returns (deadzone) that skip their synopsis - Those end when the next one starts
+    void closeOpenCall(const char *prefix)
+    {
+        Call *call = openCallNamed(prefix);
+        if (call)
+        {
+            call->end = clock;
+            call->finished = true;
+            call->name += " (returned early)";
+        }
+    }
+};
+
+bool slowerFirst(const Call &a, const Call &b) { return (a.end - a.start) > (b.end - b.start); }
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s LOG.TXT\n", argv[0]);
+        return 2;
+    }
+
+    ReplayBackend backend;
+    if (!backend.load(argv[1]))
+    {
+        fprintf(stderr, "Couldn't find any REC lines in %s\n", argv[1]);
+        return 2;
+    }
+    hostBackend = &backend;
+
+    // The replay reads the recording, it doesn't write a new one
+    isReplaying = true;
+
+    const char *endReason = "robot code returned";
+    try
+    {
+        robotMain();
+    }
+    catch (ReplayFinished finished)
+    {
+        static char reason[64];
+        snprintf(reason, sizeof(reason), "ran out of recorded '%c' inputs", finished.type);
+        endReason = reason;
+    }
+
+    printf("Replay ended at t = %.3f s (%.3f s into the recording): %s, %zu recorded inputs unread\n",
+           backend.clock, backend.clock - backend.firstTime, endReason, backend.inputsLeft());
+
+    // Command diff
+    const char *types = "LRS";
+    for (const char *type = types; *type; type++)
+        printf("  %c commands: %zu recorded, %zu replayed\n", *type, backend.outputs[*type].size(), backend.outputsSeen[*type]);
+
+    if (backend.mismatches.empty())
+        printf("All replayed commands match the recording.\n");
+    else
+    {
+        printf("%zu replayed commands differ from the recording (first 20):\n", backend.mismatches.size());
+        for (size_t i = 0; i < backend.mismatches.size() && i < 20; i++)
+        {
+            Mismatch &mismatch = backend.mismatches[i];
+            if (mismatch.isExtra)
+                printf("  t = %8.3f  %c #%zu: not in recording, replay gave %.3f\n", mismatch.time, mismatch.type, mismatch.index, mismatch.replayed);
+            else
+                printf("  t = %8.3f  %c #%zu: recorded %.3f, replay gave %.3f\n", mismatch.time, mismatch.type, mismatch.index, mismatch.recorded, mismatch.replayed);
+        }
+    }
+
+    // Profile
+    std::vector<Call> slowest = backend.calls;
+    std::sort(slowest.begin(), slowest.end(), slowerFirst);
+    printf("Slowest calls on the course:\n");
+    for (size_t i = 0; i < slowest.size() && i < 15; i++)
+        printf("  %7.3f s  starting t = %8.3f  %s\n", slowest[i].end - slowest[i].start, slowest[i].start, slowest[i].name.c_str());
+
+    return backend.mismatches.empty() ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+/*
+ * routeopt.cpp - Searches for faster in-between waypoints for finalRoutine (the RouteWaypoints in CustomLibraries/route.h).
+ *
+ * Every candidate route gets checked against the course map (CustomLibraries/course.h) first, and then run through the
+ * whole routine in the simulator on a handful of seeds (half blue DDR light, half red), across every CPU core. A route only
+ * counts if it never hits anything, always finishes, and still lines up with every task within the error limit. Of the
+ * routes that count, the fastest one on average wins.
+ *
+ * The search is a pattern search: every waypoint coordinate gets nudged both ways each round, the best nudge is kept, and
+ * the nudges get smaller whenever nothing helps.
+ *
+ * The course layout comes from a calibration - Pass the SD log from a calibrate() run with --calibration to optimize for
+ * that course, otherwise it uses the simulator's default one.
+ *
+ * Build (from the repository root):
+ *     g++ -std=c++11 -O2 -ISimulator/Libraries -ICustomLibraries Simulator/routeopt.cpp -o routeopt
+ *
+ * Run:
+ *     ./routeopt [--calibration LOG.TXT] [--seeds 4] [--rounds 12] [--error-limit 1.5]
+ *
+ * It prints how long each segment takes with the current and the new route, and a RouteWaypoints to paste into route.h.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "simulation.h"
+
+// One waypoint coordinate and how far the search may move it from where it is now
+struct Knob
+{
+    const char *name;
+    float RouteWaypoints::*field;
+    float range;
+};
+
+const Knob KNOBS[] =
+{
+    { "ddrStagingY", &RouteWaypoints::ddrStagingY, 2.5 },
+    { "rampBottomX", &RouteWaypoints::rampBottomX, 3 },
+    { "rampBottomY", &RouteWaypoints::rampBottomY, 3 },
+    { "rampTopX", &RouteWaypoints::rampTopX, 3 },
+    { "rampTopY", &RouteWaypoints::rampTopY, 4 },
+    { "leverApproachX", &RouteWaypoints::leverApproachX, 3 },
+    { "leverApproachY", &RouteWaypoints::leverApproachY, 3 }
+};
+const int KNOB_COUNT = sizeof(KNOBS) / sizeof(KNOBS[0]);
+
+// Extra room (on top of ROBOT_RADIUS) that every waypoint has to leave around obstacles
+const float WAYPOINT_MARGIN = .25;
+
+int seedCount = 4;
+float errorLimit = 1.5;
+RouteWaypoints original;
+
+/**
+ * @brief waypointsAreClear checks every point a route would send the robot to (worked out the same way finalRoutine does)
+ * against the course map, so obviously bad routes never get simulated.
+ */
+bool waypointsAreClear(const RouteWaypoints &r)
+{
+    calibrateFromWorld();
+    float points[][2] =
+    {
+        { robot.calibration.ddrBlueLightX, robot.calibration.ddrLightY + r.ddrStagingY },
+        { robot.calibration.ddrBlueLightX - 4.25f, robot.calibration.ddrLightY + r.ddrStagingY },
+        { robot.calibration.ddrBlueLightX + r.rampBottomX, robot.calibration.ddrLightY + r.rampBottomY },
+        { robot.calibration.ddrBlueLightX + r.rampTopX, r.rampTopY },
+        { robot.calibration.leverX + r.leverApproachX, robot.calibration.leverY + r.leverApproachY }
+    };
+
+    for (size_t i = 0; i < sizeof(points) / sizeof(points[0]); i++)
+        if (courseObstacleAt(points[i][0], points[i][1], ROBOT_RADIUS + WAYPOINT_MARGIN) != -1)
+            return false;
+    return true;
+}
+
+struct Score
+{
+    bool feasible;
+    double meanTime;
+    double worstError;
+    int collisions;
+    std::vector<RunResult> runs;
+};
+
+std::vector<Score> scoreAll(const std::vector<RouteWaypoints> &routes)
+{
+    std::vector<Score> scores(routes.size());
+    std::vector<int> toSimulate;
+    for (size_t i = 0; i < routes.size(); i++)
+    {
+        scores[i].feasible = waypointsAreClear(routes[i]);
+        scores[i].meanTime = 1e9;
+        scores[i].worstError = 0;
+        scores[i].collisions = 0;
+        if (scores[i].feasible)
+            toSimulate.push_back(i);
+    }
+
+    std::vector<RunResult> runs = runInParallel(toSimulate.size() * seedCount, [&](int index)
+    {
+        route = routes[toSimulate[index / seedCount]];
+        return simulateFinalRoutine(defaultScenario(index % seedCount));
+    });
+
+    for (size_t t = 0; t < toSimulate.size(); t++)
+    {
+        Score &score = scores[toSimulate[t]];
+        score.meanTime = 0;
+        for (int s = 0; s < seedCount; s++)
+        {
+            const RunResult &run = runs[t * seedCount + s];
+            score.runs.push_back(run);
+            score.meanTime += run.time / seedCount;
+            score.worstError = std::max(score.worstError, run.worstTaskError);
+            score.collisions += (int) run.collisions;
+            if (!run.finished || run.collisions > 0 || run.worstTaskError > errorLimit)
+                score.feasible = false;
+        }
+    }
+
+    return scores;
+}
+
+// Loads station positions from the "Token X: ..." style lines calibrate() writes to the SD log
+void loadCalibration(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        fprintf(stderr, "Couldn't open %s\n", path);
+        exit(2);
+    }
+
+    struct { const char *format; float *value; } lines[] =
+    {
+        { "Token X: %f", &SIM_STATIONS[0].x }, { "Token Y: %f", &SIM_STATIONS[0].y }, { "Token Heading: %f", &SIM_STATIONS[0].heading },
+        { "DDR Blue X: %f", &SIM_STATIONS[1].x }, { "DDR Y: %f", &SIM_STATIONS[1].y },
+        { "RPS Button X: %f", &SIM_STATIONS[2].x }, { "RPS Button Y: %f", &SIM_STATIONS[2].y }, { "RPS Button Heading: %f", &SIM_STATIONS[2].heading },
+        { "Foosball Start X: %f", &SIM_STATIONS[3].x }, { "Foosball Start Y: %f", &SIM_STATIONS[3].y },
+        { "Lever X: %f", &SIM_STATIONS[4].x }, { "Lever Y: %f", &SIM_STATIONS[4].y }
+    };
+
+    char text[512];
+    int found = 0;
+    while (fgets(text, sizeof(text), file))
+        for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+            if (sscanf(text, lines[i].format, lines[i].value) == 1)
+                found++;
+    fclose(file);
+
+    printf("Loaded %d calibration values from %s\n", found, path);
+}
+
+void printScore(const char *label, const Score &score)
+{
+    printf("%-20s %s   mean time %6.2f s   worst task error %5.2f in   %d collisions\n",
+           label, score.feasible ? "ok     " : "REJECTED", score.meanTime, score.worstError, score.collisions);
+    fflush(stdout);
+}
+
+// Average time per segment for the runs with the given light colour (red runs have one more segment than blue ones)
+void printSegments(const Score &before, const Score &after, bool blue)
+{
+    printf("\n%s DDR light:\n", blue ? "Blue" : "Red");
+    printf("  %-3s %-22s %-22s %9s %9s %9s\n", "#", "current target", "new target", "current", "new", "saved");
+
+    int count = 0, runsCounted = 0;
+    std::vector<double> beforeTimes(MAX_SEGMENTS, 0), afterTimes(MAX_SEGMENTS, 0);
+    const RunResult *example = 0, *newExample = 0;
+    for (int s = 0; s < seedCount; s++)
+    {
+        if (defaultScenario(s).ddrLightIsBlue != blue)
+            continue;
+
+        const RunResult &b = before.runs[s], &a = after.runs[s];
+        count = (int) std::min(b.segmentCount, a.segmentCount);
+        for (int i = 0; i < count; i++)
+        {
+            beforeTimes[i] += b.segmentTimes[i];
+            afterTimes[i] += a.segmentTimes[i];
+        }
+        example = &b;
+        newExample = &a;
+        runsCounted++;
+    }
+
+    for (int i = 0; i < count && runsCounted > 0; i++)
+    {
+        char current[32], changed[32];
+        snprintf(current, sizeof(current), "(%.2f, %.2f)", example->segmentTargets[i][0], example->segmentTargets[i][1]);
+        snprintf(changed, sizeof(changed), "(%.2f, %.2f)", newExample->segmentTargets[i][0], newExample->segmentTargets[i][1]);
+        printf("  %-3d %-22s %-22s %8.2fs %8.2fs %8.2fs\n", i + 1, current, changed,
+               beforeTimes[i] / runsCounted, afterTimes[i] / runsCounted, (beforeTimes[i] - afterTimes[i]) / runsCounted);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int rounds = 12;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--calibration")) loadCalibration(argv[i + 1]);
+        else if (!strcmp(argv[i], "--seeds")) seedCount = std::max(2, atoi(argv[i + 1]));
+        else if (!strcmp(argv[i], "--rounds")) rounds = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--error-limit")) errorLimit = atof(argv[i + 1]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--calibration LOG.TXT] [--seeds N] [--rounds N] [--error-limit INCHES]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("Optimizing %d waypoint coordinates over %d seeds on %d cores\n", KNOB_COUNT, seedCount, coreCount());
+
+    original = route;
+    Score originalScore = scoreAll(std::vector<RouteWaypoints>(1, original))[0];
+    printScore("current route", originalScore);
+    if (!originalScore.feasible)
+        printf("The current route is rejected on this course - Anything that's feasible will count as better.\n");
+
+    RouteWaypoints best = original;
+    Score bestScore = originalScore;
+    float step = 2;
+
+    for (int round = 0; round < rounds && step >= .25; round++)
+    {
+        std::vector<RouteWaypoints> candidates;
+        for (int i = 0; i < KNOB_COUNT; i++)
+            for (int direction = -1; direction <= 1; direction += 2)
+            {
+                RouteWaypoints candidate = best;
+                float moved = candidate.*KNOBS[i].field + direction * step;
+                if (fabs(moved - original.*KNOBS[i].field) > KNOBS[i].range)
+                    continue;
+                candidate.*KNOBS[i].field = moved;
+                candidates.push_back(candidate);
+            }
+
+        std::vector<Score> scores = scoreAll(candidates);
+        int winner = -1;
+        for (size_t c = 0; c < candidates.size(); c++)
+        {
+            bool beats = scores[c].feasible && (!bestScore.feasible || scores[c].meanTime < bestScore.meanTime - .05);
+            if (beats && (winner < 0 || scores[c].meanTime < scores[winner].meanTime))
+                winner = c;
+        }
+
+        char label[32];
+        snprintf(label, sizeof(label), "round %d (step %.2f)", round + 1, step);
+        if (winner >= 0)
+        {
+            best = candidates[winner];
+            bestScore = scores[winner];
+        }
+        else
+            step /= 2;
+        printScore(label, bestScore);
+    }
+
+    printf("\n");
+    printScore("current route", originalScore);
+    printScore("best route", bestScore);
+
+    if (!bestScore.feasible || (originalScore.feasible && bestScore.meanTime >= originalScore.meanTime))
+    {
+        printf("Nothing beat the current route.\n");
+        return 0;
+    }
+
+    if (originalScore.feasible)
+    {
+        printSegments(originalScore, bestScore, true);
+        printSegments(originalScore, bestScore, false);
+    }
+
+    printf("\n// Found by Simulator/routeopt.cpp - %.2f s average in simulation (was %.2f s)\nRouteWaypoints route =\n{\n", bestScore.meanTime, originalScore.meanTime);
+    for (int i = 0; i < KNOB_COUNT; i++)
+        printf("    %.4g%s // %s\n", best.*KNOBS[i].field, i + 1 < KNOB_COUNT ? "," : " ", KNOBS[i].name);
+    printf("};\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+#ifndef SIMULATOR_SIMULATION_H
+#define SIMULATOR_SIMULATION_H
+
+/*
+ * Shared by the simulation tools: pulls in the robot code, runs pieces of it against a SimulatedWorld, and spreads
+ * lots of runs across every CPU core.
+ *
+ * Everything the robot code keeps between calls is in "robot" or another ROBOT_STATE global, and those are thread_local
+ * here (see backend.h). Each run gets a brand new thread - It starts from a clean robot, and the thread ending throws that
+ * robot away.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "world.h"
+
+// Pulls in all of the robot code, with its main() renamed so the tool can have its own
+#define main robotMain
+#include "../main.cpp"
+#undef main
+
+// Most goToPoint calls a run can have and still get every one of them timed
+const int MAX_SEGMENTS = 48;
+
+// Everything the tools want to know about a simulated run (plain numbers only)
+struct RunResult
+{
+    double finished;            // 1 if the run got to the end, 0 if it timed out
+    double time;                // Seconds from the start light to the end
+    double worstTaskError;      // Inches - Worst lineup over every task the arm was used on
+    double tasksAttempted;
+    double distanceDriven;      // Inches
+    double collisions;          // Times the robot ran into something it shouldn't have
+    double controlIterations;   // Passes through goToPoint/turn control loops
+    double finalError;          // Inches from where the robot ended up to the last point goToPoint was sent to
+
+    // Seconds from the start of each goToPoint call to the start of the next one (the last one runs to the end)
+    double segmentCount;
+    double segmentTimes[MAX_SEGMENTS];
+    float segmentTargets[MAX_SEGMENTS][2];
+};
+
+// Fills in the calibration globals with where everything really is, like a perfect calibrate() would, then sets up the
+// task order planner the same way main() does after calibrate()
+void calibrateFromWorld()
+{
+    robot.calibration.tokenX = SIM_STATIONS[0].x; robot.calibration.tokenY = SIM_STATIONS[0].y; robot.calibration.tokenHeading = SIM_STATIONS[0].heading;
+    robot.calibration.ddrBlueLightX = SIM_STATIONS[1].x; robot.calibration.ddrLightY = SIM_STATIONS[1].y;
+    robot.calibration.rpsButtonX = SIM_STATIONS[2].x; robot.calibration.rpsButtonY = SIM_STATIONS[2].y; robot.calibration.rpsButtonHeading = SIM_STATIONS[2].heading;
+    robot.calibration.foosballStartX = SIM_STATIONS[3].x; robot.calibration.foosballStartY = SIM_STATIONS[3].y;
+    robot.calibration.foosballEndX = robot.calibration.foosballStartX - 10; robot.calibration.foosballEndY = robot.calibration.foosballStartY;
+    robot.calibration.leverX = SIM_STATIONS[4].x; robot.calibration.leverY = SIM_STATIONS[4].y; robot.calibration.leverHeading = SIM_STATIONS[4].heading;
+    fillTaskStops();
+}
+
+RunResult resultOf(SimulatedWorld &world, double startTime, bool finished)
+{
+    RunResult result;
+    result.finished = finished;
+    result.time = world.time - startTime;
+    result.worstTaskError = world.worstTaskError();
+    result.tasksAttempted = world.taskAttempts.size();
+    result.distanceDriven = world.distanceDriven;
+    result.collisions = world.collisions;
+    result.controlIterations = controlIterations;
+    result.finalError = world.markers.empty() ? 0 : world.distanceTo(world.markers.back().targetX, world.markers.back().targetY);
+
+    result.segmentCount = 0;
+    for (size_t i = 0; i < world.markers.size() && i < (size_t) MAX_SEGMENTS; i++)
+    {
+        double end = i + 1 < world.markers.size() ? world.markers[i + 1].time : world.time;
+        result.segmentTimes[i] = end - world.markers[i].time;
+        result.segmentTargets[i][0] = world.markers[i].targetX;
+        result.segmentTargets[i][1] = world.markers[i].targetY;
+        result.segmentCount++;
+    }
+    return result;
+}
+
+/**
+ * @brief simulateFinalRoutine runs finalRoutine() from the start light to the end button in a simulated world.
+ * Only call this on a fresh thread (see runInParallel) - It leaves the robot globals dirty.
+ */
+RunResult simulateFinalRoutine(const SimScenario &scenario)
+{
+    SimulatedWorld world(scenario);
+    hostBackend = &world;
+    calibrateFromWorld();
+
+    bool finished = true;
+    try
+    {
+        finalRoutine();
+    }
+    catch (SimTimeout)
+    {
+        finished = false;
+    }
+
+    return resultOf(world, 0, finished);
+}
+
+/**
+ * @brief recordSimulatedRun runs the whole program (robotMain(), from init() and calibrate() on) in a simulated world with
+ * recording on, and writes everything it sends to the SD log to logPath - A log Simulator/replay.cpp can play back.
+ * Like on the robot, it reads and writes TASKSTAT.TXT, MOTORMAP.TXT and CHECKPNT.TXT in the working directory, so play
+ * it back from a directory holding the same ones this run started with. Only call this on a fresh thread.
+ * @return Whether the log could be written and the run got to the end.
+ */
+bool recordSimulatedRun(const SimScenario &scenario, const char *logPath)
+{
+    FILE *log = fopen(logPath, "w");
+    if (!log)
+        return false;
+
+    SimulatedWorld world(scenario);
+    world.logFile = log;
+    hostBackend = &world;
+    isRecording = true;
+
+    bool finished = true;
+    try
+    {
+        robotMain();
+    }
+    catch (SimTimeout)
+    {
+        finished = false;
+    }
+
+    fclose(log);
+    return finished;
+}
+
+/**
+ * @brief simulateSegment runs one piece of finalRoutine (tokenSegment(), rampSegment(), ...) on its own, with the robot
+ * placed wherever that piece would normally start. Only call this on a fresh thread, same as simulateFinalRoutine.
+ * @param deadzoneUnlocked is whether the RPS button has already been pressed (anything after rpsButtonSegment).
+ */
+RunResult simulateSegment(void (*segment)(), const SimScenario &scenario, float x, float y, float heading, bool deadzoneUnlocked)
+{
+    SimulatedWorld world(scenario);
+    hostBackend = &world;
+    calibrateFromWorld();
+
+    world.placeRobot(x, y, heading);
+    robot.hardware.armServo.SetDegree(30);
+    if (deadzoneUnlocked)
+        world.deadzoneUnlockedUntil = scenario.deadzoneUnlockSeconds;
+    robot.lastValid.x = x;
+    robot.lastValid.y = y;
+    robot.lastValid.heading = heading;
+
+    bool finished = true;
+    try
+    {
+        segment();
+    }
+    catch (SimTimeout)
+    {
+        finished = false;
+    }
+
+    return resultOf(world, 0, finished);
+}
+
+int coreCount()
+{
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores > 0 ? (int) cores : 1;
+}
+
+/**
+ * @brief runInParallel calls evaluate(i) for every i in [0, count), each on a thread of its own, with up to one run per core.
+ * @param evaluate is anything callable as RunResult evaluate(int). It can change any robot global it wants - Those are
+ * per thread, so no other run (and not the caller) sees it.
+ * @return The results, in index order.
+ */
+template <class Evaluate>
+std::vector<RunResult> runInParallel(int count, Evaluate evaluate)
+{
+    std::vector<RunResult> results(count);
+    int workerCount = std::min(coreCount(), count);
+
+    // Each worker takes every workerCount-th run - Every run takes about as long, so that keeps them all busy. Each run
+    // still gets a new thread, since the thread that ran the last one has that run's robot in it.
+    std::vector<std::thread> workers;
+    for (int w = 0; w < workerCount; w++)
+    {
+        workers.push_back(std::thread([&, w]()
+        {
+            for (int i = w; i < count; i += workerCount)
+            {
+                std::thread run([&, i]()
+                {
+                    memset(&results[i], 0, sizeof(RunResult));
+                    try
+                    {
+                        results[i] = evaluate(i);
+                    }
+                    catch (...)
+                    {
+                        results[i].finished = 0;
+                    }
+                });
+                run.join();
+            }
+        }));
+    }
+
+    for (size_t w = 0; w < workers.size(); w++)
+        workers[w].join();
+    return results;
+}
+
+#endif // SIMULATOR_SIMULATION_H
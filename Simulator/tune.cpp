@@ -0,0 +1,418 @@
+/*
+ * tune.cpp - Searches for a better NavigationTuning (see CustomLibraries/navigation.h) by simulating finalRoutine.
+ *
+ * Every candidate set of thresholds gets run through the whole routine on a handful of simulated courses (same seeds for
+ * every candidate, half blue DDR light and half red), spread across every CPU core. A candidate's score is its average
+ * run time, plus a big penalty for every run where the robot lined up with a task worse than the error limit or never
+ * finished. So this finds the fastest tuning that's still accurate enough - not just the fastest one.
+ *
+ * The search goes in two stages:
+ *  1. A grid sweep - Each threshold gets tried at several values across its range with the rest held still
+ *  2. CMA-ES - Starts from the best combination the grid found and tunes everything together (the thresholds interact a lot)
+ *
+ * Build (from the repository root):
+ *     g++ -std=c++11 -O2 -ISimulator/Libraries -ICustomLibraries Simulator/tune.cpp -o tune
+ *
+ * Run:
+ *     ./tune [--seeds 6] [--grid 5] [--generations 30] [--error-limit 1.5]
+ *
+ * It finishes by printing a NavigationTuning to paste over the one in navigation.h. Check it on the real course before
+ * trusting it - the simulation is only roughly our robot.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "simulation.h"
+
+// One tunable threshold and the range it gets searched over
+struct Knob
+{
+    const char *name;
+    float NavigationTuning::*field;
+    float low, high;
+};
+
+const Knob KNOBS[] =
+{
+    { "correctionBand", &NavigationTuning::correctionBand, 1, 8 },
+    { "majorCorrectionBand", &NavigationTuning::majorCorrectionBand, 15, 60 },
+    { "largeCorrectionBand", &NavigationTuning::largeCorrectionBand, 6, 30 },
+    { "smallCorrectionScale", &NavigationTuning::smallCorrectionScale, .2, .9 },
+    { "largeCorrectionScale", &NavigationTuning::largeCorrectionScale, 0, .6 },
+    { "slowDownDistance", &NavigationTuning::slowDownDistance, 1, 10 },
+    { "controlLoopSleep", &NavigationTuning::controlLoopSleep, .005, .06 },
+    { "turnTolerance", &NavigationTuning::turnTolerance, 3, 15 },
+    { "turnFastBand", &NavigationTuning::turnFastBand, 30, 90 },
+    { "turnMediumBand", &NavigationTuning::turnMediumBand, 10, 45 },
+    { "turnRightFastBand", &NavigationTuning::turnRightFastBand, 20, 80 },
+    { "kindaCloseTolerance", &NavigationTuning::kindaCloseTolerance, 2, 10 },
+    { "reallyCloseTolerance", &NavigationTuning::reallyCloseTolerance, .75, 3 },
+    { "kindaClosePulse", &NavigationTuning::kindaClosePulse, .05, .3 },
+    { "reallyClosePulse", &NavigationTuning::reallyClosePulse, .03, .15 },
+    { "pulseSettleTime", &NavigationTuning::pulseSettleTime, .1, .5 }
+};
+const int KNOB_COUNT = sizeof(KNOBS) / sizeof(KNOBS[0]);
+
+// Search happens in [0, 1] for every knob so that CMA-ES treats them all the same
+typedef std::vector<double> Point;
+
+int seedCount = 6;
+float errorLimit = 1.5;
+
+NavigationTuning tuningAt(const Point &point)
+{
+    NavigationTuning candidate = tuning;
+    for (int i = 0; i < KNOB_COUNT; i++)
+    {
+        double unit = std::min(1.0, std::max(0.0, point[i]));
+        candidate.*KNOBS[i].field = KNOBS[i].low + unit * (KNOBS[i].high - KNOBS[i].low);
+    }
+    return candidate;
+}
+
+Point pointOf(const NavigationTuning &candidate)
+{
+    Point point(KNOB_COUNT);
+    for (int i = 0; i < KNOB_COUNT; i++)
+        point[i] = (candidate.*KNOBS[i].field - KNOBS[i].low) / (KNOBS[i].high - KNOBS[i].low);
+    return point;
+}
+
+struct Score
+{
+    double cost;
+    double meanTime;
+    double worstError;
+    int failures;       // Runs that didn't finish or missed the error limit
+};
+
+// Runs every candidate on every seed at once, then boils each candidate's runs down to one score
+std::vector<Score> scoreAll(const std::vector<Point> &points)
+{
+    std::vector<RunResult> runs = runInParallel(points.size() * seedCount, [&](int index)
+    {
+        tuning = tuningAt(points[index / seedCount]);
+        return simulateFinalRoutine(defaultScenario(index % seedCount));
+    });
+
+    std::vector<Score> scores(points.size());
+    for (size_t p = 0; p < points.size(); p++)
+    {
+        Score &score = scores[p];
+        score.cost = score.meanTime = score.worstError = 0;
+        score.failures = 0;
+
+        for (int s = 0; s < seedCount; s++)
+        {
+            const RunResult &run = runs[p * seedCount + s];
+            score.meanTime += run.time / seedCount;
+            score.worstError = std::max(score.worstError, run.worstTaskError);
+
+            if (!run.finished)
+            {
+                score.cost += 500;
+                score.failures++;
+            }
+            else if (run.worstTaskError > errorLimit)
+            {
+                score.cost += 50 + 100 * (run.worstTaskError - errorLimit);
+                score.failures++;
+            }
+        }
+
+        // Going outside a knob's range costs a little, so CMA-ES doesn't wander off past the edges
+        double outside = 0;
+        for (int i = 0; i < KNOB_COUNT; i++)
+            outside += pow(std::max(0.0, -points[p][i]) + std::max(0.0, points[p][i] - 1), 2);
+
+        score.cost += score.meanTime + 100 * outside;
+    }
+
+    return scores;
+}
+
+void printScore(const char *label, const Score &score)
+{
+    printf("%-24s cost %8.2f   mean time %6.2f s   worst task error %5.2f in   %d/%d runs failed\n",
+           label, score.cost, score.meanTime, score.worstError, score.failures, seedCount);
+    fflush(stdout);
+}
+
+/**
+ * @brief gridStage tries every knob at several evenly spaced values with the rest held at start, then keeps every
+ * knob's best value if the combination of all of them actually beats start.
+ */
+Point gridStage(const Point &start, const Score &startScore, int steps, Score &bestScore)
+{
+    std::vector<Point> points;
+    for (int i = 0; i < KNOB_COUNT; i++)
+        for (int g = 0; g < steps; g++)
+        {
+            Point point = start;
+            point[i] = steps == 1 ? .5 : g / (double) (steps - 1);
+            points.push_back(point);
+        }
+
+    std::vector<Score> scores = scoreAll(points);
+
+    Point combined = start;
+    for (int i = 0; i < KNOB_COUNT; i++)
+    {
+        double bestCost = startScore.cost;
+        for (int g = 0; g < steps; g++)
+            if (scores[i * steps + g].cost < bestCost)
+            {
+                bestCost = scores[i * steps + g].cost;
+                combined[i] = points[i * steps + g][i];
+            }
+    }
+
+    Score combinedScore = scoreAll(std::vector<Point>(1, combined))[0];
+    printScore("grid (all best values)", combinedScore);
+
+    // The knobs interact, so each one's best value on its own doesn't always add up - Fall back to the single best change
+    size_t single = std::min_element(scores.begin(), scores.end(), [](const Score &a, const Score &b) { return a.cost < b.cost; }) - scores.begin();
+    printScore("grid (best single knob)", scores[single]);
+
+    bestScore = startScore;
+    Point best = start;
+    if (scores[single].cost < bestScore.cost)
+    {
+        best = points[single];
+        bestScore = scores[single];
+    }
+    if (combinedScore.cost < bestScore.cost)
+    {
+        best = combined;
+        bestScore = combinedScore;
+    }
+    return best;
+}
+
+// Eigendecomposition of a symmetric matrix (Jacobi rotations) - vectors come back as columns
+void symmetricEigen(std::vector<Point> matrix, Point &values, std::vector<Point> &vectors)
+{
+    int n = matrix.size();
+    vectors.assign(n, Point(n, 0));
+    for (int i = 0; i < n; i++)
+        vectors[i][i] = 1;
+
+    for (int sweep = 0; sweep < 100; sweep++)
+    {
+        double offDiagonal = 0;
+        for (int p = 0; p < n; p++)
+            for (int q = p + 1; q < n; q++)
+                offDiagonal += matrix[p][q] * matrix[p][q];
+        if (offDiagonal < 1e-20)
+            break;
+
+        for (int p = 0; p < n; p++)
+            for (int q = p + 1; q < n; q++)
+            {
+                if (fabs(matrix[p][q]) < 1e-300)
+                    continue;
+
+                double theta = (matrix[q][q] - matrix[p][p]) / (2 * matrix[p][q]);
+                double t = (theta >= 0 ? 1 : -1) / (fabs(theta) + sqrt(theta * theta + 1));
+                double c = 1 / sqrt(t * t + 1), s = t * c;
+
+                for (int k = 0; k < n; k++)
+                {
+                    double kp = matrix[k][p], kq = matrix[k][q];
+                    matrix[k][p] = c * kp - s * kq;
+                    matrix[k][q] = s * kp + c * kq;
+                }
+                for (int k = 0; k < n; k++)
+                {
+                    double pk = matrix[p][k], qk = matrix[q][k];
+                    matrix[p][k] = c * pk - s * qk;
+                    matrix[q][k] = s * pk + c * qk;
+                }
+                for (int k = 0; k < n; k++)
+                {
+                    double kp = vectors[k][p], kq = vectors[k][q];
+                    vectors[k][p] = c * kp - s * kq;
+                    vectors[k][q] = s * kp + c * kq;
+                }
+            }
+    }
+
+    values.resize(n);
+    for (int i = 0; i < n; i++)
+        values[i] = matrix[i][i];
+}
+
+/**
+ * @brief cmaesStage is plain CMA-ES (Hansen's standard settings) started from start with step size sigma.
+ */
+Point cmaesStage(const Point &start, int generations, double sigma, Score &bestScore)
+{
+    const int n = KNOB_COUNT;
+    const int lambda = 4 + (int) (3 * log((double) n));
+    const int mu = lambda / 2;
+
+    Point weights(mu);
+    double weightSum = 0, weightSquares = 0;
+    for (int i = 0; i < mu; i++)
+        weightSum += weights[i] = log(mu + .5) - log(i + 1.0);
+    for (int i = 0; i < mu; i++)
+        weightSquares += (weights[i] /= weightSum) * weights[i];
+    const double mueff = 1 / weightSquares;
+
+    const double cc = (4 + mueff / n) / (n + 4 + 2 * mueff / n);
+    const double cs = (mueff + 2) / (n + mueff + 5);
+    const double c1 = 2 / ((n + 1.3) * (n + 1.3) + mueff);
+    const double cmu = std::min(1 - c1, 2 * (mueff - 2 + 1 / mueff) / ((n + 2) * (n + 2) + mueff));
+    const double damps = 1 + 2 * std::max(0.0, sqrt((mueff - 1) / (n + 1)) - 1) + cs;
+    const double chiN = sqrt((double) n) * (1 - 1.0 / (4 * n) + 1.0 / (21.0 * n * n));
+
+    Point mean = start, pc(n, 0), ps(n, 0);
+    std::vector<Point> C(n, Point(n, 0));
+    for (int i = 0; i < n; i++)
+        C[i][i] = 1;
+
+    std::mt19937 random(1281);
+    std::normal_distribution<double> normal(0, 1);
+    Point best = start;
+
+    for (int generation = 0; generation < generations; generation++)
+    {
+        Point D;
+        std::vector<Point> B;
+        symmetricEigen(C, D, B);
+        for (int i = 0; i < n; i++)
+            D[i] = sqrt(std::max(D[i], 1e-20));
+
+        // Sample
+        std::vector<Point> samples(lambda, Point(n)), steps(lambda, Point(n));
+        for (int k = 0; k < lambda; k++)
+        {
+            Point z(n);
+            for (int i = 0; i < n; i++)
+                z[i] = D[i] * normal(random);
+            for (int i = 0; i < n; i++)
+            {
+                steps[k][i] = 0;
+                for (int j = 0; j < n; j++)
+                    steps[k][i] += B[i][j] * z[j];
+                samples[k][i] = mean[i] + sigma * steps[k][i];
+            }
+        }
+
+        std::vector<Score> scores = scoreAll(samples);
+        std::vector<int> order(lambda);
+        for (int k = 0; k < lambda; k++)
+            order[k] = k;
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return scores[a].cost < scores[b].cost; });
+
+        if (scores[order[0]].cost < bestScore.cost)
+        {
+            bestScore = scores[order[0]];
+            best = samples[order[0]];
+        }
+
+        char label[32];
+        snprintf(label, sizeof(label), "cma-es generation %d", generation + 1);
+        printScore(label, bestScore);
+
+        // Recombine
+        Point meanStep(n, 0);
+        for (int i = 0; i < mu; i++)
+            for (int j = 0; j < n; j++)
+                meanStep[j] += weights[i] * steps[order[i]][j];
+        for (int j = 0; j < n; j++)
+            mean[j] += sigma * meanStep[j];
+
+        // Evolution paths (C^-1/2 * meanStep = B * D^-1 * B^T * meanStep)
+        Point whitened(n, 0), rotated(n, 0);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                rotated[i] += B[j][i] * meanStep[j];
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                whitened[i] += B[i][j] * rotated[j] / D[j];
+
+        double psNorm = 0;
+        for (int i = 0; i < n; i++)
+        {
+            ps[i] = (1 - cs) * ps[i] + sqrt(cs * (2 - cs) * mueff) * whitened[i];
+            psNorm += ps[i] * ps[i];
+        }
+        psNorm = sqrt(psNorm);
+
+        bool hsig = psNorm / sqrt(1 - pow(1 - cs, 2.0 * (generation + 1))) / chiN < 1.4 + 2.0 / (n + 1);
+        for (int i = 0; i < n; i++)
+            pc[i] = (1 - cc) * pc[i] + (hsig ? sqrt(cc * (2 - cc) * mueff) : 0) * meanStep[i];
+
+        // Covariance
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+            {
+                double rankMu = 0;
+                for (int k = 0; k < mu; k++)
+                    rankMu += weights[k] * steps[order[k]][i] * steps[order[k]][j];
+
+                C[i][j] = (1 - c1 - cmu) * C[i][j]
+                        + c1 * (pc[i] * pc[j] + (hsig ? 0 : cc * (2 - cc) * C[i][j]))
+                        + cmu * rankMu;
+            }
+
+        sigma *= exp((cs / damps) * (psNorm / chiN - 1));
+    }
+
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    int gridSteps = 5, generations = 30;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (!strcmp(argv[i], "--seeds")) seedCount = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--grid")) gridSteps = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--generations")) generations = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--error-limit")) errorLimit = atof(argv[i + 1]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--seeds N] [--grid N] [--generations N] [--error-limit INCHES]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("Tuning %d knobs over %d seeds on %d cores, error limit %.2f in\n", KNOB_COUNT, seedCount, coreCount(), errorLimit);
+
+    Point current = pointOf(tuning);
+    Score currentScore = scoreAll(std::vector<Point>(1, current))[0];
+    printScore("current tuning", currentScore);
+
+    Score gridScore;
+    Point best = gridSteps > 0 ? gridStage(current, currentScore, gridSteps, gridScore) : current;
+    if (gridSteps <= 0)
+        gridScore = currentScore;
+
+    Score bestScore = gridScore;
+    best = cmaesStage(best, generations, .15, bestScore);
+
+    printf("\n");
+    printScore("current tuning", currentScore);
+    printScore("best found", bestScore);
+
+    if (bestScore.cost >= currentScore.cost)
+    {
+        printf("Nothing beat the current tuning.\n");
+        return 0;
+    }
+
+    NavigationTuning found = tuningAt(best);
+    printf("\n// Found by Simulator/tune.cpp - %.2f s average in simulation (was %.2f s)\nNavigationTuning tuning =\n{\n", bestScore.meanTime, currentScore.meanTime);
+    for (int i = 0; i < KNOB_COUNT; i++)
+        printf("    %.4g%s // %s\n", found.*KNOBS[i].field, i + 1 < KNOB_COUNT ? "," : " ", KNOBS[i].name);
+    printf("};\n");
+    return 0;
+}
@@ -0,0 +1,483 @@
+#ifndef SIMULATOR_WORLD_H
+#define SIMULATOR_WORLD_H
+
+/*
+ * SimulatedWorld is a HostBackend that runs a simple physics model of our robot on the course, so the real robot code
+ * can be run (and timed) without a robot. It's not meant to be exact - It's meant to be close enough that if a change makes
+ * the simulated run faster or more accurate, the real one probably got faster or more accurate too.
+ *
+ * What it models:
+ *  - Differential drive with a per-wheel top speed (so straight lines drift like the real robot), a deadband, and motor lag
+ *    (stopping is quicker than speeding up, since stopped motors brake)
+ *  - RPS with noise, a fixed update rate, and the top-of-course deadzone that the RPS button unlocks
+ *  - The ramp being slower to climb than flat ground
+ *  - Running into anything in CustomLibraries/course.h (the robot just stops, and it counts as a collision)
+ *  - The CdS cell over the start light and the DDR lights
+ *  - The bump switch on the front of the robot, which closes when the front is up against anything
+ *  - Wheel encoders - Count however far each wheel turned (either way, like our single-channel encoders), so they keep
+ *    counting when the robot's stuck against something
+ *  - How long SD writes and LCD calls block for, since all of that time passes with the motors still running
+ *  - How far off the robot was from each task when the arm went down (that's what "accuracy" means in the tools)
+ *
+ * Coordinates are RPS coordinates: inches, headings in degrees counterclockwise from east.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <FEHIO.h>
+
+#include "backend.h"
+#include "course.h"
+
+// Where a task really is on the simulated course - calibrate() would have found these
+struct SimStation
+{
+    const char *name;
+    float x, y, heading;
+    float armDegree;    // The arm goes at least this far down when doing this task
+};
+
+struct SimScenario
+{
+    unsigned int seed;
+
+    // Robot
+    float startX, startY, startHeading;
+    float leftWheelSpeed, rightWheelSpeed;  // Inches/second at 100%
+    float motorDeadband;                    // Percent below which the wheel doesn't move
+    float motorLag;                         // Seconds (time constant of the wheel speeds speeding up)
+    float motorBrakeLag;                    // Seconds (time constant of the wheel speeds slowing down - stopped motors brake)
+    float trackWidth;                       // Inches between the wheels
+    float batteryVoltage;
+    float encoderCountsPerInch;             // Of wheel travel
+
+    // RPS
+    float rpsNoise, rpsHeadingNoise;        // Standard deviations, inches and degrees
+    float rpsPeriod;                        // Seconds between RPS updates
+    float deadzoneY;                        // RPS reports -2 above this unless the deadzone is unlocked
+    float deadzoneUnlockSeconds;            // How long the RPS button unlocks the deadzone for
+
+    // Course
+    bool ddrLightIsBlue;
+    float startLightDelay;                  // Seconds after the robot starts waiting that the start light comes on
+    float rampSlowdown;                     // Fraction of speed lost while climbing the ramp
+
+    // Proteus
+    float sdWriteCost;                      // Seconds each SD.Printf blocks for
+};
+
+SimScenario defaultScenario(unsigned int seed)
+{
+    SimScenario scenario;
+    scenario.seed = seed;
+
+    scenario.startX = 8.5;
+    scenario.startY = 9.5;
+    scenario.startHeading = 60;
+    scenario.leftWheelSpeed = 16.5;
+    scenario.rightWheelSpeed = 16.5 * 1.03;
+    scenario.motorDeadband = 8;
+    scenario.motorLag = .08;
+    scenario.motorBrakeLag = .03;
+    scenario.trackWidth = 7.0;
+    scenario.batteryVoltage = 11.7;
+    scenario.encoderCountsPerInch = 40.5;
+
+    scenario.rpsNoise = .05;
+    scenario.rpsHeadingNoise = .3;
+    scenario.rpsPeriod = .05;
+    scenario.deadzoneY = 54;
+    scenario.deadzoneUnlockSeconds = 80;
+
+    scenario.ddrLightIsBlue = (seed % 2 == 0);
+    scenario.startLightDelay = 1.0;
+    scenario.rampSlowdown = .3;
+
+    scenario.sdWriteCost = .0005;
+    return scenario;
+}
+
+// Same pins as in CustomLibraries/constants.h
+const int SIM_LEFT_ENCODER_PIN = FEHIO::P1_0, SIM_RIGHT_ENCODER_PIN = FEHIO::P1_1;
+const int SIM_BUMP_SWITCH_PIN = FEHIO::P0_1;
+
+// The start light and DDR lights
+const float SIM_START_LIGHT_X = 8.5, SIM_START_LIGHT_Y = 9.5;
+const float SIM_DDR_BLUE_LIGHT_X = 27.5, SIM_DDR_RED_LIGHT_X = 23.25, SIM_DDR_LIGHT_Y = 13.5;
+
+// CdS cell readings (volts) - Brighter light reads lower
+const float SIM_AMBIENT_READING = 2.2, SIM_START_LIGHT_READING = .3, SIM_RED_READING = .45, SIM_BLUE_READING = 1.35;
+
+// Every task station, in calibrate() order - Tools can move these to match a real calibration
+SimStation SIM_STATIONS[] =
+{
+    { "token", 14, 20.5, 110, 100 },
+    { "ddr", SIM_DDR_BLUE_LIGHT_X, SIM_DDR_LIGHT_Y, 270, -1 },
+    { "rps button", 20.5, 22.5, 135, 120 },
+    { "foosball", 30, 62, 7, 90 },
+    { "lever", 8.5, 57, 100, 100 }
+};
+const int SIM_STATION_COUNT = sizeof(SIM_STATIONS) / sizeof(SIM_STATIONS[0]);
+
+// How far off the robot was the moment the arm went down on a task
+struct SimTaskAttempt
+{
+    const char *station;
+    double time;
+    float positionError, headingError;
+};
+
+// When a goToPoint (or climbRamp) call started, and where it was headed (from its log line)
+struct SimMarker
+{
+    double time;
+    float targetX, targetY;
+};
+
+// Thrown out of the robot code when a run goes on way too long (stuck in a loop that never finishes)
+struct SimTimeout {};
+
+class SimulatedWorld : public HostBackend
+{
+public:
+    SimScenario scenario;
+
+    // Robot state
+    double time;
+    float x, y, heading;
+    float leftSpeed, rightSpeed;            // Actual wheel speeds, inches/second, forwards positive
+    float leftPercent, rightPercent;        // Last commanded percents, as given to the motors (sign fixes and all)
+    double leftWheelTravel, rightWheelTravel;   // Inches each wheel has turned, either way
+    float servoDegree, servoTarget;
+
+    // RPS state
+    double lastRPSUpdate;
+    float rpsReportedX, rpsReportedY, rpsReportedHeading;
+    double deadzoneUnlockedUntil;
+    bool deadzoneActive;
+    double rpsButtonHeldFor;
+
+    // Operator
+    double startLightOnAt;
+    int touches;
+
+    // Stats
+    std::vector<SimTaskAttempt> taskAttempts;
+    std::vector<SimMarker> markers;
+    double distanceDriven;
+    int collisions;
+    int lastObstacle;
+    int sdLines, lcdCalls;
+    double timeLimit;
+
+    // Optional - every SD.Printf line gets written here too (gives a log the replay tool can read)
+    FILE *logFile;
+
+    SimulatedWorld(const SimScenario &s) : scenario(s)
+    {
+        time = 0;
+        x = scenario.startX;
+        y = scenario.startY;
+        heading = scenario.startHeading;
+        leftSpeed = rightSpeed = 0;
+        leftPercent = rightPercent = 0;
+        leftWheelTravel = rightWheelTravel = 0;
+        servoDegree = servoTarget = 30;
+
+        lastRPSUpdate = -1;
+        deadzoneUnlockedUntil = -1;
+        deadzoneActive = true;
+        rpsButtonHeldFor = 0;
+        startLightOnAt = -1;
+        touches = 0;
+
+        distanceDriven = 0;
+        collisions = 0;
+        lastObstacle = -1;
+        sdLines = lcdCalls = 0;
+        timeLimit = 400;
+        logFile = 0;
+
+        randomState = scenario.seed * 2654435761u + 12345;
+        updateRPS();
+    }
+
+    // Puts the robot somewhere specific (used to start a run partway through the course)
+    void placeRobot(float newX, float newY, float newHeading)
+    {
+        x = newX;
+        y = newY;
+        heading = newHeading;
+        leftSpeed = rightSpeed = 0;
+        updateRPS();
+    }
+
+    // Time - Everything that takes time on the Proteus calls advance(), which moves the physics along with it
+    double now() { return time; }
+    void sleep(double seconds) { advance(seconds); }
+
+    // RPS
+    float rpsX() { return inDeadzone() ? -2 : rpsReportedX; }
+    float rpsY() { return inDeadzone() ? -2 : rpsReportedY; }
+    float rpsHeading() { return inDeadzone() ? -2 : rpsReportedHeading; }
+
+    // Inputs
+    float analogValue(int pin) { return lightReading() + noise(.02); }
+    // Switches read false while they're pressed
+    bool digitalValue(int pin) { return pin == SIM_BUMP_SWITCH_PIN ? !frontIsAgainstSomething() : true; }
+    float batteryVoltage() { return scenario.batteryVoltage; }
+
+    int encoderCounts(int pin)
+    {
+        if (pin == SIM_LEFT_ENCODER_PIN)
+            return (int) (leftWheelTravel * scenario.encoderCountsPerInch);
+        if (pin == SIM_RIGHT_ENCODER_PIN)
+            return (int) (rightWheelTravel * scenario.encoderCountsPerInch);
+        return 0;
+    }
+
+    void resetEncoderCounts(int pin)
+    {
+        if (pin == SIM_LEFT_ENCODER_PIN)
+            leftWheelTravel = 0;
+        else if (pin == SIM_RIGHT_ENCODER_PIN)
+            rightWheelTravel = 0;
+    }
+
+    // The operator always touches the screen right away. During calibrate(), they've just carried the robot to the next
+    // station; the touch after that is the final touch, with the robot back on the start light.
+    bool touch(float *touchX, float *touchY)
+    {
+        *touchX = 160;
+        *touchY = 120;
+
+        // The deadzone is only turned on for the run itself, so calibrating up top works
+        if (touches < SIM_STATION_COUNT)
+        {
+            placeRobot(SIM_STATIONS[touches].x, SIM_STATIONS[touches].y, SIM_STATIONS[touches].heading);
+            deadzoneActive = false;
+        }
+        else
+        {
+            placeRobot(scenario.startX, scenario.startY, scenario.startHeading);
+            deadzoneActive = true;
+        }
+        touches++;
+
+        // The start light comes on a little while after the last touch
+        startLightOnAt = time + scenario.startLightDelay;
+        return true;
+    }
+
+    // Outputs
+    void setMotorPercent(int port, float percent)
+    {
+        if (port == 0)
+            leftPercent = percent;
+        else
+            rightPercent = percent;
+    }
+
+    void setServoDegree(int port, float degree)
+    {
+        servoTarget = degree;
+    }
+
+    // Logging & screen
+    void sdLine(const char *text)
+    {
+        sdLines++;
+        if (logFile)
+            fputs(text, logFile);
+
+        SimMarker marker;
+        if (sscanf(text, "goToPoint: End (x, y): (%f, %f)", &marker.targetX, &marker.targetY) == 2 ||
+            sscanf(text, "climbRamp: End (x, y): (%f, %f)", &marker.targetX, &marker.targetY) == 2)
+        {
+            marker.time = time;
+            markers.push_back(marker);
+        }
+        advance(scenario.sdWriteCost);
+    }
+
+    void lcdCall(double cost)
+    {
+        lcdCalls++;
+        advance(cost);
+    }
+
+    // Stats
+    float distanceTo(float targetX, float targetY) { return sqrt((x - targetX) * (x - targetX) + (y - targetY) * (y - targetY)); }
+
+    float worstTaskError()
+    {
+        float worst = 0;
+        for (size_t i = 0; i < taskAttempts.size(); i++)
+            if (taskAttempts[i].positionError > worst)
+                worst = taskAttempts[i].positionError;
+        return worst;
+    }
+
+    void advance(double seconds)
+    {
+        const double STEP = .001;
+        while (seconds > 1e-9)
+        {
+            double dt = seconds < STEP ? seconds : STEP;
+            step(dt);
+            seconds -= dt;
+        }
+    }
+
+private:
+    unsigned int randomState;
+
+    // Uniform on [0, 1)
+    double uniform()
+    {
+        randomState = randomState * 1664525u + 1013904223u;
+        return (randomState >> 8) / 16777216.0;
+    }
+
+    // Roughly normal with the given standard deviation (sum of uniforms)
+    float noise(float deviation)
+    {
+        double sum = 0;
+        for (int i = 0; i < 12; i++)
+            sum += uniform();
+        return (sum - 6) * deviation;
+    }
+
+    bool inDeadzone() { return deadzoneActive && y > scenario.deadzoneY && time > deadzoneUnlockedUntil; }
+
+    // Whether the very front of the robot is touching anything (within a tenth of an inch)
+    bool frontIsAgainstSomething()
+    {
+        float frontX = x + ROBOT_RADIUS * cos(heading * M_PI / 180), frontY = y + ROBOT_RADIUS * sin(heading * M_PI / 180);
+        return courseObstacleAt(frontX, frontY, .1) != -1;
+    }
+
+    bool onRamp() { return x > COURSE_RAMP_LEFT && x < COURSE_RAMP_RIGHT && y > COURSE_RAMP_BOTTOM && y < COURSE_RAMP_TOP; }
+
+    // Wheel speed a motor percent would eventually settle at
+    float wheelTarget(float percent, float topSpeed)
+    {
+        if (fabs(percent) < scenario.motorDeadband)
+            return 0;
+        if (percent > 100) percent = 100;
+        if (percent < -100) percent = -100;
+        return percent / 100 * topSpeed * (scenario.batteryVoltage / 11.7);
+    }
+
+    // How far a wheel gets towards its target speed this step - Slowing down happens faster than speeding up
+    float wheelBlend(float speed, float target, double dt)
+    {
+        bool isSlowing = fabs(target) < fabs(speed) || target * speed < 0;
+        return dt / ((isSlowing ? scenario.motorBrakeLag : scenario.motorLag) + dt);
+    }
+
+    float lightReading()
+    {
+        if (startLightOnAt >= 0 && time >= startLightOnAt && distanceTo(SIM_START_LIGHT_X, SIM_START_LIGHT_Y) < 2.5)
+            return SIM_START_LIGHT_READING;
+
+        float litX = scenario.ddrLightIsBlue ? SIM_DDR_BLUE_LIGHT_X : SIM_DDR_RED_LIGHT_X;
+        if (distanceTo(litX, SIM_DDR_LIGHT_Y) < 1.5)
+            return scenario.ddrLightIsBlue ? SIM_BLUE_READING : SIM_RED_READING;
+
+        return SIM_AMBIENT_READING;
+    }
+
+    void updateRPS()
+    {
+        rpsReportedX = x + noise(scenario.rpsNoise);
+        rpsReportedY = y + noise(scenario.rpsNoise);
+        rpsReportedHeading = fmod(heading + noise(scenario.rpsHeadingNoise) + 360, 360);
+        lastRPSUpdate = time;
+    }
+
+    void step(double dt)
+    {
+        time += dt;
+        if (time > timeLimit)
+            throw SimTimeout();
+
+        // Wheels (left motor's sign is flipped on the robot, so forwards is a negative percent)
+        float leftTarget = wheelTarget(-leftPercent, scenario.leftWheelSpeed);
+        float rightTarget = wheelTarget(rightPercent, scenario.rightWheelSpeed);
+        leftSpeed += (leftTarget - leftSpeed) * wheelBlend(leftSpeed, leftTarget, dt);
+        rightSpeed += (rightTarget - rightSpeed) * wheelBlend(rightSpeed, rightTarget, dt);
+        leftWheelTravel += fabs(leftSpeed) * dt;
+        rightWheelTravel += fabs(rightSpeed) * dt;
+
+        // Climbing the ramp is slower than coming down it
+        float forward = (leftSpeed + rightSpeed) / 2;
+        float climb = onRamp() ? sin(heading * M_PI / 180) : 0;
+        if (climb * forward > 0)
+            forward *= 1 - scenario.rampSlowdown * fabs(climb);
+
+        float turnRate = (rightSpeed - leftSpeed) / scenario.trackWidth;
+        heading = fmod(heading + turnRate * dt * 180 / M_PI + 360, 360);
+        float nextX = x + forward * cos(heading * M_PI / 180) * dt;
+        float nextY = y + forward * sin(heading * M_PI / 180) * dt;
+
+        // Anything in the way just stops the robot (it can still turn in place) - Counts once per thing hit
+        int obstacle = courseObstacleAt(nextX, nextY, ROBOT_RADIUS);
+        if (obstacle == -1)
+        {
+            distanceDriven += fabs(forward) * dt;
+            x = nextX;
+            y = nextY;
+        }
+        else if (obstacle != lastObstacle && (obstacle == -2 || !COURSE_OBSTACLES[obstacle].isPushedOn))
+            collisions++;
+        lastObstacle = obstacle;
+
+        // Arm
+        float servoStep = 400 * dt;
+        float previousDegree = servoDegree;
+        if (fabs(servoTarget - servoDegree) <= servoStep)
+            servoDegree = servoTarget;
+        else
+            servoDegree += servoTarget > servoDegree ? servoStep : -servoStep;
+        if (previousDegree < 90 && servoDegree >= 90)
+            armWentDown();
+
+        // Holding the arm on the RPS button unlocks the deadzone
+        if (servoDegree >= SIM_STATIONS[2].armDegree && distanceTo(SIM_STATIONS[2].x, SIM_STATIONS[2].y) < 2)
+        {
+            rpsButtonHeldFor += dt;
+            if (rpsButtonHeldFor > 1)
+                deadzoneUnlockedUntil = time + scenario.deadzoneUnlockSeconds;
+        }
+
+        if (time - lastRPSUpdate >= scenario.rpsPeriod)
+            updateRPS();
+    }
+
+    // Scores how well the robot was lined up with whichever task it was closest to
+    void armWentDown()
+    {
+        int closest = -1;
+        for (int i = 0; i < SIM_STATION_COUNT; i++)
+            if (SIM_STATIONS[i].armDegree > 0 && (closest < 0 || distanceTo(SIM_STATIONS[i].x, SIM_STATIONS[i].y) < distanceTo(SIM_STATIONS[closest].x, SIM_STATIONS[closest].y)))
+                closest = i;
+
+        // Only the first time counts (foosball puts the arm down twice, the second time after pulling the counters over)
+        for (size_t i = 0; i < taskAttempts.size(); i++)
+            if (taskAttempts[i].station == SIM_STATIONS[closest].name)
+                return;
+
+        SimTaskAttempt attempt;
+        attempt.station = SIM_STATIONS[closest].name;
+        attempt.time = time;
+        attempt.positionError = distanceTo(SIM_STATIONS[closest].x, SIM_STATIONS[closest].y);
+        float headingError = fabs(fmod(heading - SIM_STATIONS[closest].heading + 540, 360) - 180);
+        attempt.headingError = headingError;
+        taskAttempts.push_back(attempt);
+    }
+};
+
+#endif // SIMULATOR_WORLD_H
@@ -1,5 +1,5 @@
 // FEH-Specific Libraries
-#include <FEHLCD.H> // Necessary for during-test debug information
+#include <FEHLCD.h> // Necessary for during-test debug information
 #include <FEHSD.h> // Necessary for post-test debug information
 #include <FEHBattery.h> // Necessary for voltage check at beginning
 
@@ -9,10 +9,20 @@
 #include <ctime>
 
 // Custom Libraries
+#include "CustomLibraries/budget.h"
+#include "CustomLibraries/checkpoint.h"
 #include "CustomLibraries/constants.h"
+#include "CustomLibraries/mission.h"
 #include "CustomLibraries/posttest.h"
+#include "CustomLibraries/push.h"
 #include "CustomLibraries/pretest.h"
 #include "CustomLibraries/navigation.h"
+#include "CustomLibraries/pathplanner.h"
+#include "CustomLibraries/posepath.h"
+#include "CustomLibraries/ramp.h"
+#include "CustomLibraries/route.h"
+#include "CustomLibraries/startlight.h"
+#include "CustomLibraries/taskorder.h"
 #include "CustomLibraries/testing.h"
 
 using namespace std;
@@ -20,42 +30,60 @@ using namespace std;
 void init(); void deinit();
 void loopWhileStartLightIsOff();
 void performanceTest4();
-void finalRoutine();
+void finalRoutine(int firstStep = 0);
+void tokenSegment(); void ddrSegment(); void rpsButtonSegment(); void rampSegment();
+void foosballSegment(); void leverSegment(); void endButtonSegment();
 void rpsTest();
 void updateLastValidRPSValues();
 void turnSouthAndGoUntilRPS(float startHeading);
 void calibrate();
 
+// What runs each task - Order has to match the TASK_ enum in budget.h
+void (*const TASK_SEGMENTS[TASK_COUNT])() =
+{
+    tokenSegment, ddrSegment, rpsButtonSegment, rampSegment, foosballSegment, leverSegment, endButtonSegment
+};
+
 int main(void)
 {
     // Initializes RPS & SD Card
     init();
 
+    // Reads in the mission script off of the SD card, if there is one (see mission.h)
+    loadMission();
+
+    // If the Proteus reset partway through a run and the robot is still where it was, this picks the run back up (see checkpoint.h)
+    int resumeStep = missionStepCount > 0 ? -1 : loadCheckpoint();
+    if (resumeStep > 0)
+    {
+        fillTaskStops();
+        robot.hardware.armServo.SetDegree(30);
+        finalRoutine(resumeStep);
+        deinit();
+        return 0;
+    }
+
     // Calibration procedure
     calibrate();
 
+    // Works out where each task starts and ends from the calibrated stations, for planning the task order (taskorder.h)
+    fillTaskStops();
+
     // This is where we put the token in
-    armServo.SetDegree(30);
+    robot.hardware.armServo.SetDegree(30);
 
     // This is our "final action"
-    LCD.WriteLine("Waiting for final touch.");
+    setStatusMessage("Waiting for final touch.");
     loopUntilTouch();
 
     // Sensing the start light, automatically triggering if it takes more than 30 seconds
-    int iterationCount = 0;
-    while (lightSensor.Value() > .75 && iterationCount < 300)
-    {
-        iterationCount++;
+    loopWhileStartLightIsOff();
 
-        clearLCD();
-        LCD.WriteLine("Waiting for start light.");
-        SD.Printf("Waiting for start light.\r\n");
-
-        Sleep(.1);
-    }
-
-    // Runs any code from the current routine
-    finalRoutine();
+    // Runs any code from the current routine - The mission script if there is one, otherwise the built-in one
+    if (missionStepCount > 0)
+        runMission();
+    else
+        finalRoutine();
 
     // Shuts down whatever needs shut down at the end of a run
     deinit();
@@ -66,109 +94,155 @@ int main(void)
 
 /**
  * @brief finalRoutine is the chain of goToPoint (and other misc. function) calls that make up our final competition run.
+ * It's split up by task so each piece can be run (and benchmarked, see Simulator/benchmark.cpp) on its own, and so the
+ * match-time budget (budget.h) can shorten or skip pieces when the run is going long.
+ * @param firstStep is where to start - Only anything but 0 when picking a run back up after a reset (see checkpoint.h).
  */
-void finalRoutine()
+void finalRoutine(int firstStep)
 {
-    /* Navigating to the token drop */
-    // Approximate, Faster Positioning
-    goToPoint(TOKEN_X - 4, TOKEN_Y - 3, false, 0.0, false, 0.0, false, 6);
+    // A fresh run saves step 0 right away, so nothing the last run left behind can get picked up partway through this one
+    if (firstStep == 0)
+    {
+        startMatchBudget();
+        saveCheckpoint(0);
+    }
 
-    // More precise, slower positioning
-    goToPoint(TOKEN_X, TOKEN_Y, true, TOKEN_HEADING, false, 0.0, false, 0);
+    for (int i = firstStep; i < TASK_COUNT; i++)
+    {
+        // Re-plans the order of whatever's left from wherever the last task actually ended (see taskorder.h)
+        updateLastValidRPSValues();
+        planTaskOrder(i, robot.lastValid.x, robot.lastValid.y, robot.lastValid.heading);
+
+        runTask(taskOrder[i], TASK_SEGMENTS[taskOrder[i]]);
+
+        // So a reset from here on doesn't lose what's been done
+        saveCheckpoint(i + 1);
+    }
+}
+
+/**
+ * @brief tokenSegment goes from the start light to the token machine and drops the token in.
+ */
+void tokenSegment()
+{
+    /* Navigating to the token drop */
+    // One curve from wherever we are into the token drop, already facing the token machine
+    goToPose(robot.calibration.tokenX, robot.calibration.tokenY, robot.calibration.tokenHeading, false, 3);
 
     // Small wind-down time so that the next method run starts with an accurate heading
     Sleep(.2);
 
     // Turns slowly, but really precisely
-    turnToAngleWhenAlreadyReallyClose(TOKEN_HEADING);
+    turnToAngleWhenAlreadyReallyClose(robot.calibration.tokenHeading);
+
+    // Dropping the token - Eases the arm down (a degree every .0075 seconds), lets the token fall for half a second, then
+    // waits for the arm to get back up before driving off
+    moveArm(115, 1 / .0075, .5);
+    waitForArm();
+    moveArm(30);
+    waitForArm();
+}
 
-    // Dropping the token
-    float currentDegree = 30;
-    while (currentDegree <= 115)
-    {
-        armServo.SetDegree(currentDegree);
-        currentDegree++;
-        Sleep(.0075);
-    }
-    Sleep(.5);
-    armServo.SetDegree(30);
-    Sleep(.5);
+/**
+ * @brief ddrSegment reads the DDR light on the way down to the red button, and holds down the button of the same color.
+ */
+void ddrSegment()
+{
+    float redX = robot.calibration.ddrBlueLightX - 4.25, blueX = robot.calibration.ddrBlueLightX;
+    float stagingY = robot.calibration.ddrLightY + route.ddrStagingY;
 
-    // Go to the side of one of the lights so that we can correctly align onto the close button
-    goToPoint(16, 15, false, 0.0, false, 0.0, false, 6);
+    // Long enough on the button to get the bonus too, unless the budget says there isn't time for it
+    // Timed from when the button actually goes down (see push.h), so there's no padding for the drive onto it
+    float holdSeconds = isTaskShortened(TASK_DDR) ? 4.5 : 20.5;
 
-    // Go on top of the near light
-    goToPoint(DDR_BLUE_LIGHT_X - 4.25, DDR_LIGHT_Y, false, 0.0, false, 0.0, false, 2);
+    // Positioning above the red button - The red light is on the way down to it
+    goToPose(redX, stagingY, 270, false, 3);
 
-    // Reading light sensor output
-    leftMotor.Stop();
-    rightMotor.Stop();
-    SD.Printf("Light Sensor Output: %f\r\n", lightSensor.Value());
+    // Give first tolerance check in next function time to catch up (had minor issues w/ this otherwise, so this is here as insurance)
+    Sleep(.4);
 
-    // If the light is blue, do this pathfinding and press the blue button
-    if (lightSensor.Value() > 1.0)
-    {
-        // Positioning approximately above the blue button
-        goToPoint(DDR_BLUE_LIGHT_X, DDR_LIGHT_Y + 5, true, 270, false, 0.0, false, 3);
+    // Was having consistency issues with being straight enough, so this one should reduce the angle we're currently at from like += 10 degrees to += 5
+    turnToAngleWhenKindaClose(270);
 
-        // Give first tolerance check in next function time to catch up (had minor issues w/ this otherwise, so this is here as insurance)
-        Sleep(.4);
+    // Driving down into the red button, reading the light the whole way (see ddrlight.h) - If the red light isn't lit, this
+    // stops as soon as it's been over it, without ever stopping the motors
+    startDDRLightSampling();
+    PushResult push = pushUntilContact(.3, hasRuledOutRedLight);
 
-        // Was having consistency issues with being straight enough, so this one should reduce the angle we're currently at from like += 10 degrees to += 5
-        turnToAngleWhenKindaClose(270);
+    // If the light is red, it's already on the button, so just hold it
+    if (classifyDDRLight().color == DDR_RED)
+    {
+        // Hitting button for long enough to get bonus goal too
+        holdPush(.3, push, holdSeconds);
 
-        // Driving down into the blue button
-        goToPoint(DDR_BLUE_LIGHT_X, DDR_LIGHT_Y - 5, false, 0.0, true, 22.0, false, 1);
+        // In the case of red, we have to back up a little bit so that we don't turn into the blue button when aligning for the RPS button
+        // Backs out in one curve, still facing the buttons, so there's no turning around right next to them
+        goToPose(blueX, stagingY, 270, true, 2);
     }
 
-    // Otherwise, the light is red, so do red button pathfinding and press the red button
+    // Otherwise, the light is blue, so back out and over to the blue button and press it
     else
     {
-        // Positioning above button
-        goToPoint(DDR_BLUE_LIGHT_X - 4.25, DDR_LIGHT_Y + 5, true, 270, false, 0.0, false, 3);
+        // Positioning approximately above the blue button, still facing the buttons
+        goToPose(blueX, stagingY, 270, true, 2);
 
         // See above note
         Sleep(.4);
-
-        // Was having consistency issues with being straight enough, so this one should reduce the angle we're currently at from like += 10 degrees to += 5
         turnToAngleWhenKindaClose(270);
 
-        // Hitting button for long enough to get bonus goal too
-        goToPoint(DDR_BLUE_LIGHT_X - 4.25, DDR_LIGHT_Y - 5, false, 0.0, true, 22.0, false, 1);
-
-        // In the case of red, we have to back up a little bit so that we don't turn into the blue button when aligning for the RPS button
-        goToPoint(DDR_BLUE_LIGHT_X, DDR_LIGHT_Y + 5, true, 90, false, 0.0, true, 2);
+        // Driving down into the blue button and holding it
+        holdPush(.3, pushUntilContact(.3), holdSeconds);
     }
+}
 
+/**
+ * @brief rpsButtonSegment goes from the DDR buttons to the RPS button and holds it down.
+ */
+void rpsButtonSegment()
+{
     // Space and angle for the RPS button
-    goToPoint(RPS_BUTTON_X, RPS_BUTTON_Y, true, RPS_BUTTON_HEADING, false, 0.0, false, 0);
+    goToPoint<Forwards, Untimed, SlowSpeed>(robot.calibration.rpsButtonX, robot.calibration.rpsButtonY, true, robot.calibration.rpsButtonHeading);
 
     // Giving goToPoint time to "wind down motors"
     Sleep(.2);
 
     // Making sure the angle for the RPS button is super accurate
-    turnToAngleWhenAlreadyReallyClose(RPS_BUTTON_HEADING);
+    turnToAngleWhenAlreadyReallyClose(robot.calibration.rpsButtonHeading);
 
     // Physically pressing the RPS button
-    armServo.SetDegree(125); Sleep(4.0);
-    armServo.SetDegree(30);
+    // Same time on the button as the old SetDegree() then Sleep(4.0), minus the time it takes the arm to get down
+    moveArm(125, 0, 3.7);
+    waitForArm();
 
+    // No need to wait for the arm to come back up - turn() doesn't go anywhere near the button
+    moveArm(30);
+}
+
+/**
+ * @brief rampSegment goes from the RPS button up the ramp to near the foosball counters.
+ */
+void rampSegment()
+{
     // So that the robot turns right to get to the bottom of the ramp and not the left (where it runs the risk of hitting the blue button)
     turn(90);
 
     // Move to bottom of ramp
-    goToPoint(DDR_BLUE_LIGHT_X, DDR_LIGHT_Y + 2, false, 0.0, false, 0.0, false, 5);
+    goToPoint<Forwards, Untimed, RampSpeed>(robot.calibration.ddrBlueLightX + route.rampBottomX, robot.calibration.ddrLightY + route.rampBottomY);
 
-    // Move up ramp and stop somewhere near the top nearish to foosball
-    // TODO - Add an additional checkpoint here so that it doesn't occasionally catch
-    goToPoint(DDR_BLUE_LIGHT_X + 2, 40, false, 0.0, false, 0.0, false, 5);
-    goToPoint(DDR_BLUE_LIGHT_X + 1.8, 57, false, 0.0, false, 0.0, false, 5);
+    // Up the ramp in one pass and stop somewhere near the top nearish to foosball (see ramp.h)
+    climbRamp(robot.calibration.ddrBlueLightX + route.rampTopX, route.rampTopY);
+}
 
+/**
+ * @brief foosballSegment lines up on the foosball counters and pulls them over.
+ */
+void foosballSegment()
+{
     // Past this point, this check needs to be here for basically every call so if it loses deadzone it skips all the way to the end
-    if (!hasExhaustedDeadzone)
+    if (!robot.hasExhaustedDeadzone)
     {
         // Positions for foosball itself
-        goToPoint(FOOSBALL_START_X, FOOSBALL_START_Y - .25, true, 7.0, false, 0.0, false, 2);
+        goToPose(robot.calibration.foosballStartX, robot.calibration.foosballStartY - .25, 7.0, false, 2);
 
         // Makes sure the motors are caught up so that the specific angle check is as accurate as possible
         Sleep(.3);
@@ -177,104 +251,86 @@ void finalRoutine()
         turnToAngleWhenAlreadyReallyClose(6);
     }
 
-    // Pressing down on the counters, giving the servo time to get down
-    armServo.SetDegree(95);
-    Sleep(.5);
+    // Pressing down on the counters, giving the servo time to get down and press in
+    moveArm(95, 0, .1);
+    waitForArm();
 
     // The "going backwards" part of foosball
-    if (!hasExhaustedDeadzone)
+    if (!robot.hasExhaustedDeadzone)
     {
-        // Physically pulling the counters over
-        leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .4);
-        rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .4);
-        Sleep(1.9);
-
-        // Stopping the motors
-        leftMotor.Stop();
-        rightMotor.Stop();
-
-        // Lifting the arm off of the counters
-        armServo.SetDegree(75);
-        // Sleep(.5); // Put this back in if it pulls the counters too far forward again at the end
+        // Physically pulling the counters over - Goes by the encoders (odometry.h), the times are what these used to be
+        driveDistance(-.4, 12.0, 1.9);
 
-        // Moving forward a little bit
-        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .2);
-        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .2);
-        Sleep(1.0);
+        // The second pull is just insurance, so it's the first thing to go when the budget is tight
+        if (!isTaskShortened(TASK_FOOSBALL))
+        {
+            // Lifting the arm off of the counters
+            robot.hardware.armServo.SetDegree(75);
+            // Sleep(.5); // Put this back in if it pulls the counters too far forward again at the end
 
-        // Stopping the motors
-        leftMotor.Stop();
-        rightMotor.Stop();
+            // Moving forward a little bit
+            driveDistance(.2, 3.1, 1.0);
 
-        // Pressing the arm onto the counters again
-        armServo.SetDegree(95);
-        Sleep(.5);
+            // Pressing the arm onto the counters again
+            moveArm(95, 0, .1);
+            waitForArm();
 
-        // Pulling the counters back again just to be sure
-        leftMotor.SetPercent(-LEFT_MOTOR_PERCENT * .2);
-        rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .2);
-        Sleep(1.0);
-
-        // Stopping the motors
-        leftMotor.Stop();
-        rightMotor.Stop();
+            // Pulling the counters back again just to be sure
+            driveDistance(-.2, 3.1, 1.0);
+        }
 
         // Rotating the arm off of the motors
-        armServo.SetDegree(30);
-        Sleep(.5);
+        moveArm(30);
+        waitForArm();
 
         // Only do this if we don't make the robot go above the dodecahedron
-        leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .5);
-        rightMotor.SetPercent(RIGHT_MOTOR_PERCENT * .5);
-        Sleep(1.0);
-        leftMotor.Stop();
-        rightMotor.Stop();
+        driveDistance(.5, 7.6, 1.0);
     }
+}
 
-    // Going to the left part
-    if (!hasExhaustedDeadzone)
-        goToPoint(20, 48, false, 0.0, false, 0.0, false, 6);
-
-    if (!hasExhaustedDeadzone)
-        goToPoint(8, 48, false, 0.0, false, 0.0, false, 6);
-
+/**
+ * @brief leverSegment crosses the upper level to the lever and pulls it.
+ */
+void leverSegment()
+{
     // Positioning for the lever
-    // Approximate, faster positioning most of the way there
-    if (!hasExhaustedDeadzone)
-        goToPoint(LEVER_X + 1, LEVER_Y - 4, false, 0.0, false, 0.0, false, 5);
+    // Approximate, faster positioning most of the way there (the planner finds the way across the upper level)
+    if (!robot.hasExhaustedDeadzone)
+        goToPointPlanned(robot.calibration.leverX + route.leverApproachX, robot.calibration.leverY + route.leverApproachY, false, 0.0, 6);
 
     // Positioning for the lever
     // More precise, slower positioning once we're nearly there
-    if (!hasExhaustedDeadzone)
-        goToPoint(LEVER_X, LEVER_Y, true, LEVER_HEADING, false, 1.5, false, 0);
+    if (!robot.hasExhaustedDeadzone)
+        goToPose(robot.calibration.leverX, robot.calibration.leverY, robot.calibration.leverHeading, false, 0);
 
     // Making sure tolerance check in next called function is very accurate
     Sleep(.4);
 
     // Turning really precisely to the lever
-    if (!hasExhaustedDeadzone)
-        turnToAngleWhenAlreadyReallyClose(LEVER_HEADING);
+    if (!robot.hasExhaustedDeadzone)
+        turnToAngleWhenAlreadyReallyClose(robot.calibration.leverHeading);
 
     // Pressing the lever
-    armServo.SetDegree(105);
+    robot.hardware.armServo.SetDegree(105);
     Sleep(1.0);
 
-    leftMotor.SetPercent(LEFT_MOTOR_PERCENT * .4);
-    rightMotor.SetPercent(-RIGHT_MOTOR_PERCENT * .4);
-    Sleep(.2);
-    armServo.SetDegree(30);
+    drive.Set(0, -.4);
+    schedulerSleep(.2);
+    robot.hardware.armServo.SetDegree(30);
 
     Sleep(.5);
 
-    leftMotor.Stop();
-    rightMotor.Stop();
+    drive.Stop();
+}
 
+/**
+ * @brief endButtonSegment goes down the left side of the course to the end button.
+ */
+void endButtonSegment()
+{
     /* It skips to right here if RPS drops */
-    // Approximately centered somewhere in front of the ramp
-    goToPoint(6, 55.0, false, 0.0, false, 0.0, false, 6);
-
-    // Approximately the end button
-    goToPoint(5.5, 5.0, false, 0.0, false, 0.0, false, 6);
+    // Approximately the end button - The planner takes it around the upper level's edge
+    goToPointPlanned(5.5, 5.0, false, 0.0, 6);
 }
 
 